@@ -0,0 +1,153 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <vector>
+#include "VectorFile.hpp"
+
+
+//    VectorFile.     ,   .
+//            ,  
+//   ,   . : Bench [  ]
+
+namespace
+{
+	const std::filesystem::path bench_path = std::filesystem::temp_directory_path() / "bench.bin";
+	constexpr size_t elements = 16 << 20;		// int   (64 )
+	constexpr size_t window = 64 << 10;			//  ()
+	constexpr size_t random_window = 4 << 10;	//     ()
+	constexpr size_t checksum_window = 1 << 20;	//  (  )    ()
+	constexpr int repeats = 5;
+
+	const char* filter = nullptr;
+
+	//  repeats   body ()
+	template <class Body>
+	double measure(Body&& body)
+	{
+		double best = 0;
+		for (int i = 0; i < repeats; i++)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			body();
+			const std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now() - start;
+			if (i == 0 || time.count() < best)
+			{
+				best = time.count();
+			}
+		}
+		return best;
+	}
+
+	template <class Body>
+	void run(const char* name, size_t bytes, Body&& body)
+	{
+		if (filter != nullptr && std::strstr(name, filter) == nullptr)
+		{
+			return;
+		}
+		const double ms = measure(body);
+		std::printf("%-44s %9.2f ms %9.1f MiB/s\n", name, ms, bytes / ms * 1000 / (1 << 20));
+	}
+
+	void create_file()
+	{
+		VectorFile<int> vec(bench_path, sizeof(int) * elements, 1 << 20, { .storage = StorageMode::mapped });
+		for (size_t i = 0; i < elements; i++)
+		{
+			vec[i] = static_cast<int>(i);
+		}
+	}
+
+	//     ,     
+	void storage_modes()
+	{
+		std::mt19937_64 random(1);
+		std::vector<size_t> indexes(1 << 16);
+		for (size_t& index : indexes)
+		{
+			index = random() % elements;
+		}
+		for (StorageMode storage : { StorageMode::stream, StorageMode::mapped })
+		{
+			const bool mapped = storage == StorageMode::mapped;
+			volatile long long sink = 0;
+			run(mapped ? "sequential read, mapped" : "sequential read, stream", sizeof(int) * elements, [&]
+			{
+				VectorFile<int> vec(bench_path, false, window, { .storage = storage });
+				long long sum = 0;
+				for (size_t i = 0; i < elements; i++)
+				{
+					sum += vec.get(i);
+				}
+				sink = sum;
+			});
+			run(mapped ? "sequential write, mapped" : "sequential write, stream", sizeof(int) * elements, [&]
+			{
+				VectorFile<int> vec(bench_path, true, window, { .storage = storage });
+				for (size_t i = 0; i < elements; i++)
+				{
+					vec[i] = static_cast<int>(i);
+				}
+			});
+			//      :     
+			run(mapped ? "random read 64K, window remap" : "random read 64K, window reload", sizeof(int) * indexes.size(), [&]
+			{
+				VectorFile<int> vec(bench_path, false, random_window, { .storage = storage });
+				long long sum = 0;
+				for (size_t index : indexes)
+				{
+					sum += vec.get(index);
+				}
+				sink = sum;
+			});
+		}
+	}
+
+	//          ;  -   CRC32C
+	void checksums()
+	{
+		{
+			VectorFile<int> vec(bench_path, true, checksum_window, { .checksums = true });
+			for (size_t i = 0; i < elements; i++)
+			{
+				vec[i] = static_cast<int>(i);
+			}
+		}
+		volatile long long sink = 0;
+		for (bool enabled : { false, true })
+		{
+			run(enabled ? "sequential read, checksums on" : "sequential read, checksums off", sizeof(int) * elements, [&]
+			{
+				VectorFile<int> vec(bench_path, false, checksum_window, { .checksums = enabled });
+				long long sum = 0;
+				for (size_t i = 0; i < elements; i++)
+				{
+					sum += vec.get(i);
+				}
+				sink = sum;
+			});
+		}
+		std::vector<char> bytes(sizeof(int) * elements, 1);
+		volatile uint32_t crc = 0;
+		run("crc32c", bytes.size(), [&] { crc = crc32c(bytes.data(), bytes.size()); });
+		run("crc32c, table fallback", bytes.size(), [&] { crc = crc32c_portable(bytes.data(), bytes.size()); });
+		std::filesystem::path table = bench_path;
+		table += ".crc";
+		std::filesystem::remove(table);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc > 1)
+	{
+		filter = argv[1];
+	}
+	create_file();
+	storage_modes();
+	checksums();
+	std::filesystem::remove(bench_path);
+	return 0;
+}
@@ -1,6 +1,16 @@
 #include "pch.h"
 #include "VectorFile.hpp"
+#include "vector_file_sort.hpp"
+#include "vector_file_parallel.hpp"
+#include "vector_file_shared.hpp"
+#include "vector_file_concurrent.hpp"
+#include "vector_file_records.hpp"
+#include "vector_file_compressed.hpp"
 #include "unordered_map"
+#include <list>
+#include <numeric>
+#include <random>
+#include <ranges>
 
 
 class MyType final
@@ -517,6 +527,1863 @@ TEST(Iteration, _)
 	std::filesystem::remove(p);
 }
 
+TEST(MappedStorage, ReadWrite)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	{
+		VectorFile<int> vec(p, sizeof(int) * 1000, 256, { .storage = StorageMode::mapped });
+		EXPECT_EQ(vec.size_file(), sizeof(int) * 1000);
+		for (size_t i = 0; i < 1000; i++)
+		{
+			vec[i] = static_cast<int>(i * 3);
+		}
+	}
+	{
+		VectorFile<int> vec(p, false, 128);
+		EXPECT_EQ(vec.size_file(), sizeof(int) * 1000);
+		for (size_t i = 0; i < 1000; i++)
+		{
+			EXPECT_EQ(vec[i], i * 3);
+		}
+	}
+	{
+		VectorFile<int> vec(p, false, 512, { .storage = StorageMode::mapped });
+		for (size_t i = 1000; i > 0; i--)
+		{
+			EXPECT_EQ(vec[i - 1], (i - 1) * 3);
+		}
+		vec[0] = 42;
+		EXPECT_THROW(vec.flush(), write_error);
+	}
+	{
+		VectorFile<int> vec(p);
+		EXPECT_EQ(vec[0], 0);
+	}
+	std::filesystem::remove(p);
+}
+
+TEST(MappedStorage, PushPop)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	{
+		VectorFile<int> vec(p, sizeof(int) * 10, 64, { .storage = StorageMode::mapped });
+		for (int i = 0; i < 100; i++)
+		{
+			vec.push_back(i);
+		}
+		EXPECT_EQ(vec.size_file(), sizeof(int) * 110);
+		for (int i = 99; i >= 50; i--)
+		{
+			EXPECT_EQ(vec.pop_back(), i);
+		}
+		EXPECT_EQ(vec.size_file(), sizeof(int) * 60);
+		vec[5] = 7;
+	}
+	{
+		VectorFile<int> vec(p, true, 64, { .storage = StorageMode::mapped });
+		EXPECT_EQ(vec.size_file(), sizeof(int) * 60);
+		EXPECT_EQ(vec[5], 7);
+		for (int i = 0; i < 50; i++)
+		{
+			EXPECT_EQ(vec[10 + i], i);
+		}
+		vec.resize(sizeof(int) * 200);
+	}
+	{
+		VectorFile<int> vec(p);
+		EXPECT_EQ(vec.size_file(), sizeof(int) * 200);
+		EXPECT_EQ(vec[199], 0);
+	}
+	std::filesystem::remove(p);
+}
+
+struct IntSerializer : Serializer<int> { };
+
+TEST(MappedStorage, Unsupported)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	EXPECT_THROW((VectorFile<int, IntSerializer>(p, static_cast<size_t>(16), 1024, { .storage = StorageMode::mapped })), unsupported_storage);
+	std::filesystem::remove(p);
+}
+
+struct InvertSerializer
+{
+	static void serialization(std::fstream& file, uint32_t& elem)
+	{
+		uint32_t value = ~elem;
+		file.write(reinterpret_cast<char*>(&value), sizeof(uint32_t));
+	}
+
+	static void deserialization(std::fstream& file, uint32_t& elem)
+	{
+		file.read(reinterpret_cast<char*>(&elem), sizeof(uint32_t));
+		elem = ~elem;
+	}
+
+	static size_t get_size_element(std::fstream& file)
+	{
+		return sizeof(uint32_t);
+	}
+
+	static void serialization(std::span<const uint32_t> elems, std::span<char> bytes)
+	{
+		for (size_t i = 0; i < elems.size(); i++)
+		{
+			const uint32_t value = ~elems[i];
+			std::memcpy(bytes.data() + i * sizeof(uint32_t), &value, sizeof(uint32_t));
+		}
+	}
+
+	static void deserialization(std::span<const char> bytes, std::span<uint32_t> elems)
+	{
+		for (size_t i = 0; i < elems.size(); i++)
+		{
+			std::memcpy(&elems[i], bytes.data() + i * sizeof(uint32_t), sizeof(uint32_t));
+			elems[i] = ~elems[i];
+		}
+	}
+};
+
+TEST(BulkSerializer, Custom)
+{
+	static_assert(BulkSerializer<InvertSerializer, uint32_t>);
+	static_assert(BulkSerializer<Serializer<MyType>, MyType>);
+
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	{
+		VectorFile<uint32_t, InvertSerializer> vec(p, sizeof(uint32_t) * 100, 64);
+		for (size_t i = 0; i < 100; i++)
+		{
+			vec[i] = static_cast<uint32_t>(i);
+		}
+		vec.push_back(100);
+		EXPECT_EQ(vec.pop_back(), 100);
+		vec.push_back(100);
+	}
+	{
+		VectorFile<uint32_t> vec(p);
+		EXPECT_EQ(vec.size_file(), sizeof(uint32_t) * 101);
+		EXPECT_EQ(vec[1], ~1u);
+	}
+	{
+		VectorFile<uint32_t, InvertSerializer> vec(p, false, 32);
+		for (size_t i = 0; i < 101; i++)
+		{
+			EXPECT_EQ(vec[i], i);
+		}
+	}
+	std::filesystem::remove(p);
+}
+
+TEST(Growth, Policies)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	for (GrowthPolicy growth : { GrowthPolicy::sparse, GrowthPolicy::allocate, GrowthPolicy::zero_fill })
+	{
+		{
+			VectorFile<uint64_t> vec(p, sizeof(uint64_t) * 300000, 4096, { .growth = growth });
+			vec[0] = 1;
+			vec[299999] = 2;
+			vec.pop_back();
+			vec.pop_back();
+			vec.push_back(3);
+			vec.resize(sizeof(uint64_t) * 100);
+			vec.resize(sizeof(uint64_t) * 400000);
+		}
+		EXPECT_EQ(std::filesystem::file_size(p), sizeof(uint64_t) * 400000);
+		{
+			VectorFile<uint64_t> vec(p, false, 4096);
+			EXPECT_EQ(vec[0], 1);
+			for (size_t i = 1; i < 400000; i++)
+			{
+				ASSERT_EQ(vec[i], 0);
+			}
+		}
+	}
+	std::filesystem::remove(p);
+}
+
+void overwrite_in_file(const std::filesystem::path& p, size_t offset, int value)
+{
+	std::fstream file(p, std::ios::in | std::ios::out | std::ios::binary);
+	file.seekp(offset);
+	file.write(reinterpret_cast<char*>(&value), sizeof(int));
+}
+
+TEST(DirtyTracking, CleanWindowIsNotWritten)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	{
+		VectorFile<int> vec(p, sizeof(int) * 64);
+	}
+	{
+		VectorFile<int> vec(p, true, sizeof(int) * 8);
+		EXPECT_EQ(vec.get(0), 0);
+		overwrite_in_file(p, 0, 11);
+		EXPECT_EQ(vec.get(40), 0);
+		vec.flush();
+	}
+	{
+		VectorFile<int> vec(p);
+		EXPECT_EQ(vec[0], 11);
+	}
+	std::filesystem::remove(p);
+}
+
+TEST(DirtyTracking, OnlyDirtyRangeIsWritten)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	{
+		VectorFile<int> vec(p, sizeof(int) * 64);
+	}
+	{
+		VectorFile<int> vec(p, true, sizeof(int) * 16);
+		vec[2] = 1;
+		vec[4] = 2;
+		overwrite_in_file(p, sizeof(int) * 1, 21);
+		overwrite_in_file(p, sizeof(int) * 5, 22);
+		vec.flush();
+		EXPECT_EQ(vec.get(40), 0);
+		vec[41] = 3;
+		overwrite_in_file(p, sizeof(int) * 2, 23);
+	}
+	{
+		VectorFile<int> vec(p);
+		EXPECT_EQ(vec[1], 21);
+		EXPECT_EQ(vec[2], 23);
+		EXPECT_EQ(vec[4], 2);
+		EXPECT_EQ(vec[5], 22);
+		EXPECT_EQ(vec[41], 3);
+	}
+	std::filesystem::remove(p);
+}
+
+TEST(WindowCache, AlternatingRegions)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	{
+		VectorFile<int> vec(p, sizeof(int) * 10000, sizeof(int) * 100, { .windows = 2 });
+		const size_t misses = vec.cache_misses();
+		for (int i = 0; i < 100; i++)
+		{
+			vec[i] = i;
+			vec[9900 + i] = -i;
+		}
+		EXPECT_EQ(vec.cache_misses() - misses, 1);
+		EXPECT_EQ(vec.cache_hits(), 199);
+	}
+	{
+		VectorFile<int> vec(p);
+		for (int i = 0; i < 100; i++)
+		{
+			EXPECT_EQ(vec[i], i);
+			EXPECT_EQ(vec[9900 + i], -i);
+		}
+	}
+	std::filesystem::remove(p);
+}
+
+TEST(WindowCache, LeastRecentlyUsedEviction)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	for (StorageMode storage : { StorageMode::stream, StorageMode::mapped })
+	{
+		{
+			VectorFile<int> vec(p, sizeof(int) * 4096, sizeof(int) * 64, { .storage = storage, .windows = 3 });
+			vec[0] = 1;
+			vec[1000] = 2;
+			vec[2000] = 3;
+			vec[0] = 4;
+			const size_t misses = vec.cache_misses();
+			vec[3000] = 5;
+			EXPECT_EQ(vec.cache_misses() - misses, 1);
+			EXPECT_EQ(vec.get(0), 4);
+			EXPECT_EQ(vec.get(2000), 3);
+			EXPECT_EQ(vec.cache_misses() - misses, 1);
+			EXPECT_EQ(vec.get(1000), 2);
+			EXPECT_EQ(vec.cache_misses() - misses, 2);
+			for (int i = 0; i < 10; i++)
+			{
+				vec.push_back(i);
+			}
+			EXPECT_EQ(vec.pop_back(), 9);
+			vec.resize(sizeof(int) * 3001);
+		}
+		{
+			VectorFile<int> vec(p);
+			EXPECT_EQ(vec.size_file(), sizeof(int) * 3001);
+			EXPECT_EQ(vec[0], 4);
+			EXPECT_EQ(vec[1000], 2);
+			EXPECT_EQ(vec[2000], 3);
+			EXPECT_EQ(vec[3000], 5);
+		}
+	}
+	std::filesystem::remove(p);
+}
+
+TEST(Prefetch, SequentialScan)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	{
+		VectorFile<int> vec(p, sizeof(int) * 100000, sizeof(int) * 1000);
+		for (int i = 0; i < 100000; i++)
+		{
+			vec[i] = i;
+		}
+	}
+	for (StorageMode storage : { StorageMode::stream, StorageMode::mapped })
+	{
+		VectorFile<int> vec(p, true, sizeof(int) * 1000, { .storage = storage, .windows = 2, .prefetch = true });
+		for (int i = 0; i < 100000; i++)
+		{
+			ASSERT_EQ(vec.get(i), i);
+			if (i % 3 == 0)
+			{
+				vec[i] = -i;
+			}
+		}
+		if (storage == StorageMode::stream)
+		{
+			EXPECT_GT(vec.prefetch_hits(), 90);
+		}
+		for (int i = 0; i < 100000; i++)
+		{
+			ASSERT_EQ(vec.get(i), i % 3 == 0 ? -i : i);
+			if (i % 3 == 0)
+			{
+				vec[i] = i;
+			}
+		}
+	}
+	{
+		VectorFile<uint32_t, InvertSerializer> vec(p, true, sizeof(int) * 500, { .prefetch = true });
+		for (uint32_t i = 0; i < 100000; i++)
+		{
+			ASSERT_EQ(vec.get(i), ~i);
+		}
+		EXPECT_GT(vec.prefetch_hits(), 190);
+		vec.pop_back();
+		vec.resize(sizeof(int) * 1000);
+		vec.resize(sizeof(int) * 5000);
+		for (uint32_t i = 1000; i < 5000; i++)
+		{
+			ASSERT_EQ(vec.get(i), ~0u);
+		}
+	}
+	std::filesystem::remove(p);
+}
+
+TEST(WriteBehind, SequentialIngest)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	{
+		VectorFile<int> vec(p, sizeof(int) * 100000, sizeof(int) * 1000, { .write_behind = 4 });
+		for (int i = 0; i < 100000; i++)
+		{
+			vec[i] = i;
+		}
+		vec.flush();
+		for (int i = 0; i < 100; i++)
+		{
+			vec.push_back(100000 + i);
+		}
+	}
+	{
+		VectorFile<int> vec(p, false, sizeof(int) * 3000);
+		EXPECT_EQ(vec.size_file(), sizeof(int) * 100100);
+		for (int i = 0; i < 100100; i++)
+		{
+			ASSERT_EQ(vec[i], i);
+		}
+	}
+	std::filesystem::remove(p);
+}
+
+TEST(WriteBehind, ReloadEvictedWindow)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	{
+		VectorFile<uint32_t, InvertSerializer> vec(p, sizeof(uint32_t) * 10000, sizeof(uint32_t) * 100, { .windows = 2, .prefetch = true, .write_behind = 2 });
+		for (uint32_t round = 1; round <= 3; round++)
+		{
+			for (uint32_t i = 0; i < 10000; i++)
+			{
+				vec[(i * 37) % 10000] += 1;
+				vec[i] += 1;
+			}
+		}
+		for (uint32_t i = 0; i < 10000; i++)
+		{
+			ASSERT_EQ(vec.get(i), ~0u + 6);
+		}
+		for (uint32_t i = 0; i < 5000; i++)
+		{
+			ASSERT_EQ(vec.pop_back(), ~0u + 6);
+		}
+		vec.resize(sizeof(uint32_t) * 6000);
+	}
+	{
+		VectorFile<uint32_t, InvertSerializer> vec(p);
+		EXPECT_EQ(vec.size_file(), sizeof(uint32_t) * 6000);
+		for (uint32_t i = 0; i < 6000; i++)
+		{
+			ASSERT_EQ(vec[i], i < 5000 ? ~0u + 6 : ~0u);
+		}
+	}
+	std::filesystem::remove(p);
+}
+
+TEST(AppendBuffer, PushReadPop)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	for (StorageMode storage : { StorageMode::stream, StorageMode::mapped })
+	{
+		{
+			VectorFile<int> vec(p, sizeof(int) * 10, sizeof(int) * 16, { .storage = storage, .append_buffer = sizeof(int) * 64 });
+			for (int i = 0; i < 1000; i++)
+			{
+				vec.push_back(i);
+				ASSERT_EQ(vec.get(10 + i), i);
+			}
+			EXPECT_EQ(vec.size_file(), sizeof(int) * 1010);
+			vec[1009] = -1;
+			EXPECT_EQ(vec.pop_back(), -1);
+			EXPECT_EQ(vec.pop_back(), 998);
+			vec.push_back(2000);
+			EXPECT_EQ(vec[500], 490);
+			EXPECT_EQ(vec[1008], 2000);
+		}
+		{
+			VectorFile<int> vec(p);
+			ASSERT_EQ(vec.size_file(), sizeof(int) * 1009);
+			for (int i = 0; i < 10; i++)
+			{
+				ASSERT_EQ(vec[i], 0);
+			}
+			for (int i = 0; i < 998; i++)
+			{
+				ASSERT_EQ(vec[10 + i], i);
+			}
+			EXPECT_EQ(vec[1008], 2000);
+		}
+		std::filesystem::remove(p);
+	}
+}
+
+TEST(AppendBuffer, IterateAfterGrow)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	{
+		VectorFile<int, IntSerializer> vec(p, size_t(0), sizeof(int) * 8, { .append_buffer = sizeof(int) * 5 });
+		for (int i = 0; i < 23; i++)
+		{
+			vec.push_back(i * 3);
+		}
+		vec.resize(sizeof(int) * 30);
+		vec.push_back(7);
+		int count = 0;
+		for (int value : vec)
+		{
+			EXPECT_EQ(value, count < 23 ? count * 3 : count == 30 ? 7 : 0);
+			count++;
+		}
+		EXPECT_EQ(count, 31);
+	}
+	std::filesystem::remove(p);
+}
+
+TEST(AppendRange, Blocks)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	for (StorageMode storage : { StorageMode::stream, StorageMode::mapped })
+	{
+		{
+			VectorFile<int> vec(p, sizeof(int) * 3, sizeof(int) * 64, { .storage = storage, .write_behind = storage == StorageMode::stream ? 2u : 0u, .append_buffer = sizeof(int) * 100 });
+			std::vector<int> chunk(1000);
+			for (int round = 0; round < 5; round++)
+			{
+				for (int i = 0; i < 1000; i++)
+				{
+					chunk[i] = round * 1000 + i;
+				}
+				vec.append(chunk);
+				vec.push_back(-round);
+				vec.append(std::span<const int>(chunk.data(), 10));
+			}
+			EXPECT_EQ(vec.size_file(), sizeof(int) * (3 + 5 * 1011));
+			EXPECT_EQ(vec.get(3 + 1011 + 1000), -1);
+			EXPECT_EQ(vec.get(3 + 5 * 1011 - 1), 4009);
+		}
+		{
+			VectorFile<int> vec(p);
+			ASSERT_EQ(vec.size_file(), sizeof(int) * (3 + 5 * 1011));
+			for (int round = 0; round < 5; round++)
+			{
+				const size_t base = 3 + round * 1011;
+				for (int i = 0; i < 1000; i++)
+				{
+					ASSERT_EQ(vec[base + i], round * 1000 + i);
+				}
+				ASSERT_EQ(vec[base + 1000], -round);
+				ASSERT_EQ(vec[base + 1001], round * 1000);
+			}
+		}
+		std::filesystem::remove(p);
+	}
+}
+
+TEST(AppendRange, InputIterators)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	{
+		VectorFile<uint32_t, InvertSerializer> vec(p, size_t(0), sizeof(uint32_t) * 16, { .append_buffer = sizeof(uint32_t) * 7 });
+		std::list<uint32_t> values;
+		for (uint32_t i = 0; i < 50; i++)
+		{
+			values.push_back(i * i);
+		}
+		vec.append(values.begin(), values.end());
+		vec.resize(sizeof(uint32_t) * 60);
+		vec.append(values.begin(), std::next(values.begin(), 5));
+		EXPECT_EQ(vec.get(49), 49u * 49u);
+		EXPECT_EQ(vec.get(64), 16u);
+	}
+	{
+		VectorFile<uint32_t, InvertSerializer> vec(p);
+		ASSERT_EQ(vec.size_file(), sizeof(uint32_t) * 65);
+		for (uint32_t i = 0; i < 65; i++)
+		{
+			ASSERT_EQ(vec[i], i < 50 ? i * i : i < 60 ? ~0u : (i - 60) * (i - 60));
+		}
+	}
+	std::filesystem::remove(p);
+}
+
+TEST(Range, ReadWriteCoherentWithWindows)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	for (VectorFileOptions options : { VectorFileOptions{ .windows = 2 }, VectorFileOptions{ .windows = 2, .prefetch = true, .write_behind = 2 },
+		VectorFileOptions{ .storage = StorageMode::mapped, .windows = 2 } })
+	{
+		{
+			VectorFile<int> vec(p, sizeof(int) * 1000, sizeof(int) * 64, options);
+			std::vector<int> values(1000);
+			for (int i = 0; i < 1000; i++)
+			{
+				values[i] = i;
+			}
+			vec.write_range(0, values);
+			vec[70] = -70;
+			vec[999] = -999;
+			vec.push_back(1000);
+			vec.push_back(1001);
+
+			std::vector<int> out(200);
+			vec.read_range(802, out);
+			for (int i = 0; i < 200; i++)
+			{
+				ASSERT_EQ(out[i], 802 + i == 999 ? -999 : 802 + i);
+			}
+			vec.read_range(60, std::span<int>(out.data(), 20));
+			EXPECT_EQ(out[9], 69);
+			EXPECT_EQ(out[10], -70);
+
+			std::vector<int> patch(27, 7);
+			vec.write_range(975, patch);
+			EXPECT_EQ(vec.get(999), 7);
+			EXPECT_EQ(vec.get(1001), 7);
+			EXPECT_EQ(vec.get(974), 974);
+		}
+		{
+			VectorFile<int> vec(p);
+			ASSERT_EQ(vec.size_file(), sizeof(int) * 1002);
+			std::vector<int> out(1002);
+			vec.read_range(0, out);
+			for (int i = 0; i < 1002; i++)
+			{
+				ASSERT_EQ(out[i], i >= 975 ? 7 : i == 70 ? -70 : i);
+			}
+			EXPECT_THROW(vec.read_range(1000, std::span<int>(out.data(), 3)), goind_out_of_file);
+		}
+		std::filesystem::remove(p);
+	}
+}
+
+static_assert(std::random_access_iterator<VectorFile<int>::FileIterator>);
+static_assert(std::random_access_iterator<VectorFile<int>::ConstFileIterator>);
+static_assert(!std::ranges::range<const VectorFile<int>>);
+
+TEST(RandomAccessIterator, SortAndSearch)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	for (StorageMode storage : { StorageMode::stream, StorageMode::mapped })
+	{
+		{
+			VectorFile<int> vec(p, sizeof(int) * 5000, sizeof(int) * 256, { .storage = storage, .windows = 2 });
+			for (int i = 0; i < 5000; i++)
+			{
+				vec[i] = (i * 7919) % 5000;
+			}
+			std::sort(vec.begin(), vec.end());
+			EXPECT_EQ(vec.end() - vec.begin(), 5000);
+			EXPECT_TRUE(std::is_sorted(vec.cbegin(), vec.cend()));
+			const auto found = std::lower_bound(vec.cbegin(), vec.cend(), 4321);
+			EXPECT_EQ(found - vec.cbegin(), 4321);
+			EXPECT_EQ(vec.begin()[2500], 2500);
+			std::ranges::reverse(vec);
+		}
+		{
+			VectorFile<int> vec(p);
+			int expected = 4999;
+			for (int value : std::ranges::subrange(vec.cbegin(), vec.cend()))
+			{
+				ASSERT_EQ(value, expected--);
+			}
+			EXPECT_EQ(*(vec.cend() - 1), 0);
+			EXPECT_LT(vec.cbegin() + 10, vec.cend());
+		}
+		std::filesystem::remove(p);
+	}
+}
+
+TEST(RandomAccessIterator, SortWithDefaultOptions)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	for (StorageMode storage : { StorageMode::stream, StorageMode::mapped })
+	{
+		{
+			VectorFile<int> vec(p, sizeof(int) * 1000, 1024, { .storage = storage });
+			for (int i = 0; i < 1000; i++)
+			{
+				vec[i] = (i * 7919) % 1000;
+			}
+			std::sort(vec.begin(), vec.end());
+			for (int i = 0; i < 1000; i++)
+			{
+				ASSERT_EQ(vec[i], i);
+			}
+			std::ranges::reverse(vec);
+		}
+		{
+			VectorFile<int> vec(p);
+			for (int i = 0; i < 1000; i++)
+			{
+				ASSERT_EQ(vec[i], 999 - i);
+			}
+		}
+		std::filesystem::remove(p);
+	}
+}
+
+TEST(RandomAccessIterator, ConstScanDoesNotDirty)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	{
+		VectorFile<int> vec(p, sizeof(int) * 64);
+	}
+	{
+		VectorFile<int> vec(p, true, sizeof(int) * 8);
+		EXPECT_EQ(*vec.cbegin(), 0);
+		overwrite_in_file(p, 0, 11);
+		EXPECT_EQ(std::count(vec.cbegin() + 8, vec.cend(), 0), 56);
+		vec.flush();
+	}
+	{
+		VectorFile<int> vec(p);
+		EXPECT_EQ(vec[0], 11);
+	}
+	std::filesystem::remove(p);
+}
+
+TEST(ExternalSort, MergesRuns)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	std::vector<int> expected;
+	{
+		VectorFile<int> vec(p, size_t(0), sizeof(int) * 512, { .windows = 2 });
+		for (int i = 0; i < 100000; i++)
+		{
+			vec.push_back((i * 7919) % 100000);
+			expected.push_back((i * 7919) % 100000);
+		}
+		vec[5] = -1;
+		expected[5] = -1;
+		std::sort(expected.begin(), expected.end(), std::greater<int>());
+		vf::sort(vec, std::greater<int>(), sizeof(int) * 3000);
+		EXPECT_EQ(vec.get(0), 99999);
+		EXPECT_EQ(vec.get(99999), -1);
+	}
+	EXPECT_FALSE(std::filesystem::exists(p.string() + ".runs"));
+	{
+		VectorFile<int> vec(p);
+		ASSERT_EQ(vec.size_file(), sizeof(int) * 100000);
+		for (int i = 0; i < 100000; i++)
+		{
+			ASSERT_EQ(vec[i], expected[i]);
+		}
+	}
+	std::filesystem::remove(p);
+}
+
+TEST(ExternalSort, BulkSerializerAndSmallFile)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	{
+		VectorFile<uint32_t, InvertSerializer> vec(p, sizeof(uint32_t) * 20000);
+		for (uint32_t i = 0; i < 20000; i++)
+		{
+			vec[i] = (i * 31) % 20000;
+		}
+		vf::sort(vec, std::less<uint32_t>(), sizeof(uint32_t) * 777);
+		for (uint32_t i = 0; i < 20000; i++)
+		{
+			ASSERT_EQ(vec.get(i), i);
+		}
+		vec.resize(sizeof(uint32_t) * 10);
+		vf::sort(vec, std::greater<uint32_t>());
+		EXPECT_TRUE(std::is_sorted(vec.cbegin(), vec.cend(), std::greater<uint32_t>()));
+		EXPECT_EQ(vec.get(0), 9u);
+	}
+	std::filesystem::remove(p);
+}
+
+TEST(Parallel, ForEachReduce)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	{
+		VectorFile<int> vec(p, sizeof(int) * 300000, sizeof(int) * 1000, { .write_behind = 2 });
+		for (int i = 0; i < 300000; i++)
+		{
+			vec[i] = i % 1000;
+		}
+		vec.push_back(5000);
+		std::atomic<long long> sum = 0;
+		vf::for_each(vec, [&](int value) { sum += value; }, 4);
+		EXPECT_EQ(sum, 300LL * 499500 + 5000);
+		EXPECT_EQ(vf::reduce(vec, 0LL, std::plus<long long>(), 3), 300LL * 499500 + 5000);
+		EXPECT_EQ(vf::reduce(vec, -1, [](int a, int b) { return std::max(a, b); }), 5000);
+	}
+	{
+		VectorFile<int> vec(p);
+		EXPECT_EQ(vf::reduce(vec, 0LL, std::plus<long long>()), 300LL * 499500 + 5000);
+	}
+	std::filesystem::remove(p);
+}
+
+struct Reading
+{
+	int id;
+	int n;
+};
+
+TEST(Parallel, ReduceMixedTypes)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	{
+		VectorFile<Reading> vec(p, sizeof(Reading) * 10000, sizeof(Reading) * 100);
+		for (int i = 0; i < 10000; i++)
+		{
+			vec[i] = { i, 2 };
+		}
+	}
+	{
+		VectorFile<Reading> vec(p);
+		const auto count_n = [](size_t acc, const Reading& t) { return acc + t.n; };
+		EXPECT_EQ(vf::reduce(vec, size_t{ 0 }, count_n, std::plus<size_t>(), 4), 20000u);
+		EXPECT_EQ(vf::reduce(vec, size_t{ 0 }, count_n, std::plus<size_t>()), 20000u);
+	}
+	std::filesystem::remove(p);
+}
+
+TEST(Parallel, Transform)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	auto q = std::filesystem::temp_directory_path() / "temp2.bin";
+	{
+		VectorFile<int> vec(p, sizeof(int) * 100000, sizeof(int) * 512);
+		for (int i = 0; i < 100000; i++)
+		{
+			vec[i] = i;
+		}
+		EXPECT_EQ(vec.get(10), 10);
+		vf::transform(vec, vec, [](int value) { return value * 2; }, 8);
+		EXPECT_EQ(vec.get(10), 20);
+
+		VectorFile<uint32_t, InvertSerializer> out(q, sizeof(uint32_t) * 10);
+		vf::transform(vec, out, [](int value) { return static_cast<uint32_t>(value + 1); });
+		EXPECT_EQ(out.size_file(), sizeof(uint32_t) * 100000);
+		EXPECT_EQ(out.get(0), 1u);
+		EXPECT_EQ(out.get(99999), 199999u);
+	}
+	{
+		VectorFile<uint32_t, InvertSerializer> out(q);
+		for (uint32_t i = 0; i < 100000; i++)
+		{
+			ASSERT_EQ(out[i], i * 2 + 1);
+		}
+	}
+	std::filesystem::remove(p);
+	std::filesystem::remove(q);
+}
+
+TEST(SharedReaders, CursorsPerThread)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	{
+		VectorFile<uint32_t, InvertSerializer> vec(p, size_t(0));
+		for (uint32_t i = 0; i < 50000; i++)
+		{
+			vec.push_back(i * 3);
+		}
+	}
+	{
+		const SharedVectorFile<uint32_t, InvertSerializer> file(p, sizeof(uint32_t) * 256);
+		EXPECT_EQ(file.size_file(), sizeof(uint32_t) * 50000);
+		std::atomic<size_t> errors = 0;
+		std::vector<std::thread> threads;
+		for (uint32_t t = 0; t < 8; t++)
+		{
+			threads.emplace_back([&file, &errors, t]
+			{
+				auto cursor = file.cursor();
+				for (uint32_t i = 0; i < 20000; i++)
+				{
+					const uint32_t index = (i * 7919 + t * 1000) % 50000;
+					if (cursor[index] != index * 3)
+					{
+						++errors;
+					}
+				}
+				std::vector<uint32_t> out(100);
+				cursor.read_range(49900, out);
+				if (out[99] != 49999 * 3)
+				{
+					++errors;
+				}
+			});
+		}
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+		EXPECT_EQ(errors, 0);
+		auto cursor = file.cursor();
+		EXPECT_THROW(cursor[50000], goind_out_of_file);
+		EXPECT_EQ(cursor[49999], 49999u * 3);
+		EXPECT_EQ(cursor.size_buffer(), 50000u % 256);
+	}
+	std::filesystem::remove(p);
+}
+
+TEST(ConcurrentWriter, DisjointRegionsAndPushBack)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	{
+		VectorFile<int> vec(p, sizeof(int) * 160000);
+	}
+	{
+		ConcurrentVectorFile<int> vec(p, sizeof(int) * 256, 16, 64);
+		std::vector<std::thread> threads;
+		for (int t = 0; t < 16; t++)
+		{
+			threads.emplace_back([&vec, t]
+			{
+				for (int i = 0; i < 10000; i++)
+				{
+					vec.store(t * 10000 + i, t * 10000 + i);
+				}
+				for (int i = 0; i < 10000; i += 100)
+				{
+					vec.update(t * 10000 + i, [](int& value) { value = -value; });
+				}
+				for (int i = 0; i < 500; i++)
+				{
+					vec.push_back(1000000 + t);
+				}
+			});
+		}
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+		EXPECT_EQ(vec.size_file(), sizeof(int) * 168000);
+		EXPECT_EQ(vec.load(100), -100);
+		EXPECT_EQ(vec.load(101), 101);
+		EXPECT_THROW(vec.load(168000), goind_out_of_file);
+	}
+	{
+		VectorFile<int> vec(p);
+		ASSERT_EQ(vec.size_file(), sizeof(int) * 168000);
+		for (int i = 0; i < 160000; i++)
+		{
+			ASSERT_EQ(vec[i], i % 100 == 0 ? -i : i);
+		}
+		std::vector<int> counts(16);
+		for (int i = 160000; i < 168000; i++)
+		{
+			ASSERT_GE(vec[i], 1000000);
+			ASSERT_LT(vec[i], 1000016);
+			counts[vec[i] - 1000000]++;
+		}
+		EXPECT_EQ(std::count(counts.begin(), counts.end(), 500), 16);
+	}
+	std::filesystem::remove(p);
+}
+
+TEST(ConcurrentWriter, FlushAndResize)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	{
+		VectorFile<uint32_t, InvertSerializer> vec(p, size_t(0));
+	}
+	{
+		ConcurrentVectorFile<uint32_t, InvertSerializer> vec(p, sizeof(uint32_t) * 64, 4, 8);
+		for (uint32_t i = 0; i < 1000; i++)
+		{
+			vec.push_back(i);
+		}
+		vec.flush();
+		EXPECT_EQ(std::filesystem::file_size(p), sizeof(uint32_t) * 1000);
+		vec.resize(sizeof(uint32_t) * 500);
+		vec.push_back(7);
+		EXPECT_EQ(vec.load(500), 7u);
+		EXPECT_EQ(vec.load(499), 499u);
+	}
+	{
+		VectorFile<uint32_t, InvertSerializer> vec(p);
+		ASSERT_EQ(vec.size_file(), sizeof(uint32_t) * 501);
+		EXPECT_EQ(vec[0], 0u);
+		EXPECT_EQ(vec[499], 499u);
+		EXPECT_EQ(vec[500], 7u);
+	}
+	std::filesystem::remove(p);
+}
+
+TEST(WindowView, ZeroCopySpans)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	for (StorageMode storage : { StorageMode::stream, StorageMode::mapped })
+	{
+		{
+			VectorFile<int> vec(p, sizeof(int) * 1000, sizeof(int) * 128, { .storage = storage, .windows = 2 });
+			for (size_t first = 0; first < 1000;)
+			{
+				auto view = vec.window_view(first, 1000 - first);
+				ASSERT_GT(view.size(), 0u);
+				ASSERT_LE(view.size(), vec.window_elements());
+				std::iota(view.begin(), view.end(), static_cast<int>(first));
+				first += view.size();
+			}
+			auto head = vec.read_view(10, 5);
+			EXPECT_EQ(head.size(), 5u);
+			EXPECT_EQ(std::accumulate(head.begin(), head.end(), 0), 10 + 11 + 12 + 13 + 14);
+			auto tail = vec.read_view(250, 100);
+			EXPECT_EQ(tail.size(), 6u);
+			EXPECT_EQ(tail[5], 255);
+			EXPECT_THROW(vec.get(500), window_pinned);
+			EXPECT_EQ(vec.get(3), 3);
+		}
+		{
+			VectorFile<int> vec(p);
+			for (int i = 0; i < 1000; i++)
+			{
+				ASSERT_EQ(vec[i], i);
+			}
+		}
+		std::filesystem::remove(p);
+	}
+}
+
+TEST(HotPath, UncheckedAccessInCurrentWindow)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	{
+		VectorFile<int> vec(p, sizeof(int) * 1000, sizeof(int) * 100, { .windows = 2 });
+		for (int i = 0; i < 1000; i++)
+		{
+			vec[i] = i;
+		}
+		long long sum = 0;
+		for (size_t i = 0; i < 1000; i++)
+		{
+			if (!vec.in_window(i))
+			{
+				vec.seek_window(i);
+			}
+			sum += vec.at_unchecked(i);
+		}
+		EXPECT_EQ(sum, 999LL * 1000 / 2);
+		EXPECT_TRUE(vec.in_window(950));
+		EXPECT_FALSE(vec.in_window(899));
+		EXPECT_FALSE(vec.in_window(1000));
+
+		vec.resize(sizeof(int) * 950);
+		EXPECT_FALSE(vec.in_window(950));
+		EXPECT_THROW(vec[950], goind_out_of_file);
+		EXPECT_EQ(vec.pop_back(), 949);
+		EXPECT_FALSE(vec.in_window(949));
+		EXPECT_EQ(vec[948], 948);
+	}
+	std::filesystem::remove(p);
+}
+
+TEST(FixedWindow, CompileTimeWindowSize)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	for (StorageMode storage : { StorageMode::stream, StorageMode::mapped })
+	{
+		{
+			VectorFile<int, Serializer<int>, 64> vec(p, sizeof(int) * 1000, 12345, { .storage = storage, .windows = 3 });
+			EXPECT_EQ(vec.window_elements(), 64u);
+			EXPECT_EQ(vec.size_buffer(), 64u);
+			for (int i = 0; i < 1000; i++)
+			{
+				vec[i] = 999 - i;
+			}
+			vec.push_back(-1);
+			vf::sort(vec);
+			EXPECT_EQ(vec.get(0), -1);
+			vf::transform(vec, vec, [](int value) { return value + 1; });
+			EXPECT_EQ(vec.pop_back(), 1000);
+			auto view = vec.read_view(60, 10);
+			EXPECT_EQ(view.size(), 4u);
+			EXPECT_EQ(view[3], 63);
+		}
+		{
+			VectorFile<int, Serializer<int>, 128> vec(p);
+			ASSERT_EQ(vec.size_file(), sizeof(int) * 1000);
+			for (int i = 0; i < 1000; i++)
+			{
+				ASSERT_EQ(vec[i], i);
+			}
+		}
+		std::filesystem::remove(p);
+	}
+}
+
+struct Triple
+{
+	int a, b, c;
+};
+
+TEST(DirectIO, UnalignedWindowsAndTail)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	{
+		VectorFile<Triple> vec(p, sizeof(Triple) * 1001, sizeof(Triple) * 300, { .windows = 2, .append_buffer = sizeof(Triple) * 50, .direct = true });
+		for (int i = 0; i < 1001; i++)
+		{
+			vec[i] = { i, -i, i * 2 };
+		}
+		for (int i = 0; i < 77; i++)
+		{
+			vec.push_back({ 2000 + i, 0, 0 });
+		}
+		std::vector<Triple> out(500);
+		vec.read_range(333, out);
+		EXPECT_EQ(out[0].a, 333);
+		EXPECT_EQ(out[499].c, 832 * 2);
+		EXPECT_EQ(vec.pop_back().a, 2076);
+		vec.flush();
+		EXPECT_EQ(std::filesystem::file_size(p), sizeof(Triple) * 1077);
+	}
+	{
+		VectorFile<Triple> vec(p, false, sizeof(Triple) * 1000, { .direct = true });
+		ASSERT_EQ(vec.size_file(), sizeof(Triple) * 1077);
+		for (int i = 0; i < 1077; i++)
+		{
+			ASSERT_EQ(vec[i].a, i < 1001 ? i : 2000 + i - 1001);
+			ASSERT_EQ(vec[i].b, i < 1001 ? -i : 0);
+		}
+	}
+	EXPECT_THROW((VectorFile<int>(p, false, 1024, { .storage = StorageMode::mapped, .direct = true })), unsupported_storage);
+	std::filesystem::remove(p);
+}
+
+TEST(DirectIO, BlockAlignedWindows)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	for (bool header : { false, true })
+	{
+		{
+			VectorFile<Triple> vec(p, sizeof(Triple) * 5000, sizeof(Triple) * 300, { .windows = 3, .direct = true, .header = header });
+			EXPECT_EQ(vec.window_elements() * sizeof(Triple) % FileHandle::direct_alignment, 0);
+			for (int i = 0; i < 5000; i += 7)
+			{
+				vec[i] = { i, -i, i * 3 };
+			}
+			for (size_t first : { size_t(0), vec.window_elements(), vec.window_elements() * 3 })
+			{
+				EXPECT_EQ(reinterpret_cast<uintptr_t>(vec.window_view(first, 1).data()) % FileHandle::direct_alignment, 0);
+			}
+		}
+		VectorFile<Triple> vec(p, false, sizeof(Triple) * 1000, { .direct = true });
+		ASSERT_EQ(vec.size_file(), sizeof(Triple) * 5000);
+		for (int i = 0; i < 5000; i++)
+		{
+			ASSERT_EQ(vec[i].a, i % 7 == 0 ? i : 0);
+			ASSERT_EQ(vec[i].c, i % 7 == 0 ? i * 3 : 0);
+		}
+	}
+	std::filesystem::remove(p);
+}
+
+TEST(IoEngine, BatchOfRequests)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	std::ofstream(p, std::ios::binary).close();
+	std::filesystem::resize_file(p, 1 << 20);
+	for (IoEngineKind kind : { IoEngineKind::positional, IoEngineKind::uring })
+	{
+		auto engine = make_io_engine(kind, p, true, 4);
+		std::vector<std::vector<char>> blocks(10, std::vector<char>(100000));
+		std::vector<IoRequest> requests;
+		for (size_t i = 0; i < blocks.size(); i++)
+		{
+			std::fill(blocks[i].begin(), blocks[i].end(), static_cast<char>(i + 1));
+			requests.push_back({ true, i * 100000, blocks[i].data(), blocks[i].size() });
+		}
+		engine->submit(requests);
+		std::vector<char> out(1000000);
+		engine->submit(std::vector<IoRequest>{ { false, 0, out.data(), 500000 }, { false, 500000, out.data() + 500000, 500000 } });
+		for (size_t i = 0; i < out.size(); i += 99991)
+		{
+			ASSERT_EQ(out[i], static_cast<char>(i / 100000 + 1));
+		}
+		EXPECT_THROW(engine->submit(std::vector<IoRequest>{ { false, 1 << 20, out.data(), 10 } }), std::runtime_error);
+	}
+	std::filesystem::remove(p);
+}
+
+TEST(IoEngine, UringVectorFile)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	const size_t count = 3 << 20;
+	{
+		VectorFile<int> vec(p, sizeof(int) * count, 4096, { .windows = 16, .io_engine = IoEngineKind::uring });
+		std::vector<int> values(count);
+		std::iota(values.begin(), values.end(), 0);
+		vec.write_range(0, values);
+		for (size_t i = 0; i < count; i += count / 16)
+		{
+			vec[i + 5] = -1;
+		}
+		vec.flush();
+		std::vector<int> out(count);
+		vec.read_range(0, out);
+		EXPECT_EQ(out[1], 1);
+		EXPECT_EQ(out[count / 16 + 5], -1);
+		EXPECT_EQ(out[count - 1], static_cast<int>(count - 1));
+	}
+	{
+		VectorFile<int> vec(p);
+		ASSERT_EQ(vec.size_file(), sizeof(int) * count);
+		for (size_t i = 0; i < count; i += 1021)
+		{
+			ASSERT_EQ(vec[i], i % (count / 16) == 5 ? -1 : static_cast<int>(i));
+		}
+	}
+	{
+		VectorFile<uint32_t, InvertSerializer> vec(p, true, 1024, { .windows = 8, .io_engine = IoEngineKind::uring });
+		for (size_t i = 0; i < 8; i++)
+		{
+			vec[i * 10000] = 7;
+		}
+		vec.flush();
+	}
+	{
+		VectorFile<uint32_t, InvertSerializer> vec(p, false, 1024, { .io_engine = IoEngineKind::uring });
+		EXPECT_EQ(vec[30000], 7u);
+		EXPECT_EQ(vec[30001], ~30001u);
+	}
+	std::filesystem::remove(p);
+}
+
+TEST(IoEngine, BackgroundThreadsUseEngine)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	for (IoEngineKind kind : { IoEngineKind::positional, IoEngineKind::uring })
+	{
+		std::ofstream(p, std::ios::binary).close();
+		std::filesystem::resize_file(p, sizeof(uint32_t) * 1000);
+		{
+			// ,     ;   ,   - 
+			WindowWriter<uint32_t, InvertSerializer, false> writer(p, 16, kind);
+			for (uint32_t i = 0; i < 10; i++)
+			{
+				WindowBuffer<uint32_t> buffer(100, i);
+				writer.push(i * 100 * sizeof(uint32_t), std::move(buffer), 0, 100);
+			}
+			writer.push(0, WindowBuffer<uint32_t>(100, 77), 10, 20);
+			writer.drain();
+		}
+		{
+			VectorFile<uint32_t, InvertSerializer> vec(p, false, sizeof(uint32_t) * 100);
+			for (uint32_t i = 0; i < 1000; i++)
+			{
+				ASSERT_EQ(vec[i], i >= 10 && i < 20 ? 77u : i / 100);
+			}
+		}
+		WindowPrefetcher<uint32_t, InvertSerializer, false> prefetcher(p, kind);
+		prefetcher.request(3, 300 * sizeof(uint32_t), 100);
+		WindowBuffer<uint32_t> buffer;
+		ASSERT_TRUE(prefetcher.take(3, 100, buffer));
+		EXPECT_EQ(buffer, WindowBuffer<uint32_t>(100, 3));
+	}
+	std::filesystem::remove(p);
+}
+
+TEST(RecordVectorFile, VariableLengthRecords)
+{
+	auto p = std::filesystem::temp_directory_path() / "records.bin";
+	auto idx = std::filesystem::temp_directory_path() / "records.bin.idx";
+	std::filesystem::remove(p);
+	std::filesystem::remove(idx);
+	using Records = RecordVectorFile<std::vector<int>, SequenceSerializer<std::vector<int>>>;
+	{
+		Records vec(p, true, 16, 256);
+		for (int i = 0; i < 1000; i++)
+		{
+			vec.push_back(std::vector<int>(i % 7, i));
+		}
+		EXPECT_EQ(vec.size(), 1000u);
+		EXPECT_EQ(vec.record_size(999), sizeof(int) * (999 % 7));
+		EXPECT_EQ(vec.get(500), std::vector<int>(500 % 7, 500));
+		vec[10] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		vec[11].clear();
+		vec.push_back({ -1 });
+		EXPECT_EQ(vec.get(10).size(), 9u);
+		EXPECT_EQ(vec.pop_back(), std::vector<int>{ -1 });
+		EXPECT_EQ(vec.pop_back(), std::vector<int>(999 % 7, 999));
+	}
+	{
+		Records vec(p, false, 64);
+		ASSERT_EQ(vec.size(), 999u);
+		for (int i = 0; i < 999; i++)
+		{
+			if (i == 10)
+			{
+				ASSERT_EQ(vec[i], (std::vector<int>{ 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+			}
+			else
+			{
+				ASSERT_EQ(vec[i], std::vector<int>(i == 11 ? 0 : i % 7, i));
+			}
+		}
+		EXPECT_THROW(vec.get(999), goind_out_of_file);
+		EXPECT_THROW(vec.push_back({}), write_error);
+	}
+	{
+		RecordVectorFile<std::string, SequenceSerializer<std::string>> words(p.string() + ".words", true);
+		words.push_back("alpha");
+		words.push_back("");
+		words.push_back("gamma");
+		words[1] = "beta";
+	}
+	{
+		RecordVectorFile<std::string, SequenceSerializer<std::string>> words(p.string() + ".words");
+		ASSERT_EQ(words.size(), 3u);
+		EXPECT_EQ(words[1], "beta");
+		EXPECT_EQ(words[2], "gamma");
+		EXPECT_EQ(words.size_file(), 14u);
+	}
+	for (auto path : { p, idx, std::filesystem::path(p.string() + ".words"), std::filesystem::path(p.string() + ".words.idx") })
+	{
+		std::filesystem::remove(path);
+	}
+}
+
+TEST(RecordVectorFile, SlotCapacityAndStoredCount)
+{
+	auto p = std::filesystem::temp_directory_path() / "records.bin";
+	auto copy = std::filesystem::temp_directory_path() / "records_copy.bin";
+	using Records = RecordVectorFile<std::vector<int>, SequenceSerializer<std::vector<int>>>;
+	{
+		Records vec(p, true, 4, 1);
+		for (int i = 0; i < 5; i++)
+		{
+			vec.push_back(std::vector<int>(8, i));
+		}
+		//    ,  flush()   :     ,     
+		std::filesystem::copy_file(p, copy, std::filesystem::copy_options::overwrite_existing);
+		std::filesystem::copy_file(p.string() + ".idx", copy.string() + ".idx", std::filesystem::copy_options::overwrite_existing);
+		{
+			Records snapshot(copy);
+			ASSERT_EQ(snapshot.size(), 5u);
+			EXPECT_EQ(snapshot[4], std::vector<int>(8, 4));
+		}
+
+		const size_t data_size = vec.size_file();
+		vec[2] = { 1 };
+		vec.flush();
+		vec[2] = std::vector<int>(8, -2);
+		vec.flush();
+		EXPECT_EQ(vec.size_file(), data_size);
+		vec[2] = std::vector<int>(9, -2);
+		vec.flush();
+		EXPECT_EQ(vec.size_file(), data_size + sizeof(int) * 9);
+	}
+	{
+		Records vec(p);
+		ASSERT_EQ(vec.size(), 5u);
+		EXPECT_EQ(vec[1], std::vector<int>(8, 1));
+		EXPECT_EQ(vec[2], std::vector<int>(9, -2));
+		EXPECT_EQ(vec[3], std::vector<int>(8, 3));
+	}
+	for (auto path : { p, copy })
+	{
+		std::filesystem::remove(path);
+		std::filesystem::remove(path.string() + ".idx");
+	}
+}
+
+TEST(Compressed, DeltaCodecRoundTrip)
+{
+	std::vector<int64_t> values = { 5, 4, 1000000, -7, INT64_MIN, INT64_MAX, 0 };
+	std::vector<char> bytes;
+	DeltaCodec<int64_t>::encode(values, bytes);
+	std::vector<int64_t> out(values.size());
+	DeltaCodec<int64_t>::decode(bytes, out);
+	EXPECT_EQ(out, values);
+	std::vector<uint8_t> same(100, 42);
+	std::vector<char> small;
+	DeltaCodec<uint8_t>::encode(same, small);
+	EXPECT_EQ(small.size(), 2u);
+	std::vector<uint8_t> back(100);
+	DeltaCodec<uint8_t>::decode(small, back);
+	EXPECT_EQ(back, same);
+}
+
+TEST(Compressed, BlocksOnDisk)
+{
+	auto p = std::filesystem::temp_directory_path() / "compressed.bin";
+	auto table = std::filesystem::temp_directory_path() / "compressed.bin.blk";
+	std::filesystem::remove(p);
+	std::filesystem::remove(table);
+	const int count = 100000;
+	{
+		CompressedVectorFile<int> vec(p, true, 1024);
+		for (int i = 0; i < count; i++)
+		{
+			vec.push_back(1000000 + i * 3);
+		}
+		vec[500] = -5;
+		vec[70000] = INT32_MAX;
+		EXPECT_EQ(vec.get(500), -5);
+		EXPECT_EQ(vec.pop_back(), 1000000 + (count - 1) * 3);
+		vec.flush();
+		EXPECT_LT(vec.size_file(), sizeof(int) * count / 5);
+	}
+	{
+		CompressedVectorFile<int> vec(p, true, 7);
+		ASSERT_EQ(vec.size(), static_cast<size_t>(count - 1));
+		EXPECT_EQ(vec.size_buffer(), 1024u);
+		for (int i = 0; i < count - 1; i++)
+		{
+			ASSERT_EQ(vec[i], i == 500 ? -5 : i == 70000 ? INT32_MAX : 1000000 + i * 3);
+		}
+		while (vec.size() > 1000)
+		{
+			vec.pop_back();
+		}
+	}
+	{
+		CompressedVectorFile<int> vec(p);
+		ASSERT_EQ(vec.size(), 1000u);
+		EXPECT_EQ(vec.get(999), 1000000 + 999 * 3);
+		EXPECT_THROW(vec.get(1000), goind_out_of_file);
+	}
+	EXPECT_THROW((CompressedVectorFile<int64_t>(p)), format_mismatch);
+	EXPECT_THROW((CompressedVectorFile<int, RawCodec<int>>(p)), format_mismatch);
+	std::filesystem::remove(p);
+	std::filesystem::remove(table);
+	{
+		CompressedVectorFile<double> vec(p, true, 100);
+		for (int i = 0; i < 250; i++)
+		{
+			vec.push_back(i * 0.5);
+		}
+	}
+	{
+		CompressedVectorFile<double> vec(p);
+		EXPECT_EQ(vec.size_file(), sizeof(double) * 250);
+		EXPECT_EQ(vec.get(249), 124.5);
+	}
+	std::filesystem::remove(p);
+	std::filesystem::remove(table);
+}
+
+TEST(Compressed, ShrunkBlockKeepsItsPlace)
+{
+	auto p = std::filesystem::temp_directory_path() / "compressed.bin";
+	auto table = std::filesystem::temp_directory_path() / "compressed.bin.blk";
+	std::filesystem::remove(p);
+	std::filesystem::remove(table);
+	std::mt19937 gen(11);
+	std::vector<int> values(512);
+	for (int& value : values)
+	{
+		value = static_cast<int>(gen());
+	}
+	{
+		CompressedVectorFile<int> vec(p, true, 256);
+		for (int value : values)
+		{
+			vec.push_back(value);
+		}
+		vec.flush();
+		const size_t size = vec.size_file();
+		for (int round = 0; round < 10; round++)
+		{
+			for (int i = 0; i < 256; i++)
+			{
+				vec[i] = 0;
+			}
+			vec.get(300);
+			for (int i = 0; i < 256; i++)
+			{
+				vec[i] = values[i];
+			}
+			vec.get(300);
+		}
+		EXPECT_EQ(vec.size_file(), size);
+	}
+	{
+		CompressedVectorFile<int> vec(p);
+		for (int i = 0; i < 512; i++)
+		{
+			ASSERT_EQ(vec[i], values[i]);
+		}
+	}
+	std::filesystem::remove(p);
+	std::filesystem::remove(table);
+}
+
+template <class C, class T>
+void expect_round_trip(const std::vector<T>& values)
+{
+	std::vector<char> bytes;
+	C::encode(values, bytes);
+	std::vector<T> out(values.size());
+	C::decode(bytes, out);
+	ASSERT_EQ(out, values) << values.size();
+}
+
+TEST(Compressed, LaneCodecsRoundTrip)
+{
+	std::mt19937_64 random(7);
+	for (size_t count : { 0, 1, 2, 3, 127, 128, 129, 256, 1000, 4096 })
+	{
+		std::vector<int32_t> small(count), wide(count);
+		std::vector<uint64_t> stamps(count);
+		std::vector<double> series(count);
+		std::vector<float> noise(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			small[i] = -1000 + static_cast<int32_t>(random() % 50);
+			wide[i] = static_cast<int32_t>(random());
+			stamps[i] = 1700000000000ull + i * 1000 + random() % 3;
+			series[i] = 20.0 + static_cast<double>(i % 64) * 0.25;
+			noise[i] = static_cast<float>(random() % 100000) / 7.0f;
+		}
+		expect_round_trip<ForCodec<int32_t>>(small);
+		expect_round_trip<ForCodec<int32_t>>(wide);
+		expect_round_trip<ForCodec<uint64_t>>(stamps);
+		expect_round_trip<DeltaDeltaCodec<uint64_t>>(stamps);
+		expect_round_trip<DeltaDeltaCodec<int32_t>>(wide);
+		expect_round_trip<XorCodec<double>>(series);
+		expect_round_trip<XorCodec<float>>(noise);
+	}
+	std::vector<int64_t> stamps(4096);
+	for (size_t i = 0; i < stamps.size(); i++)
+	{
+		stamps[i] = 1700000000000 + static_cast<int64_t>(i) * 1000;
+	}
+	std::vector<char> bytes;
+	DeltaDeltaCodec<int64_t>::encode(stamps, bytes);
+	EXPECT_EQ(bytes.size(), 2 * sizeof(int64_t) + 1);
+	std::vector<int32_t> narrow(4096, 5);
+	narrow[100] = 20;
+	ForCodec<int32_t>::encode(narrow, bytes);
+	EXPECT_EQ(bytes.size(), sizeof(int32_t) + 1 + 4096 * 4 / 8);
+}
+
+TEST(Compressed, LaneCodecsInVectorFile)
+{
+	auto p = std::filesystem::temp_directory_path() / "compressed.bin";
+	auto table = std::filesystem::temp_directory_path() / "compressed.bin.blk";
+	std::filesystem::remove(p);
+	std::filesystem::remove(table);
+	{
+		CompressedVectorFile<double, XorCodec<double>> vec(p, true, 512);
+		for (int i = 0; i < 5000; i++)
+		{
+			vec.push_back(100.0 + (i % 200) * 0.125);
+		}
+		vec[1234] = 3.14159;
+		vec.flush();
+		EXPECT_LT(vec.size_file(), sizeof(double) * 5000 / 3);
+	}
+	{
+		CompressedVectorFile<double, XorCodec<double>> vec(p);
+		ASSERT_EQ(vec.size(), 5000u);
+		for (int i = 0; i < 5000; i++)
+		{
+			ASSERT_EQ(vec[i], i == 1234 ? 3.14159 : 100.0 + (i % 200) * 0.125);
+		}
+	}
+	EXPECT_THROW((CompressedVectorFile<double>(p)), format_mismatch);
+	std::filesystem::remove(p);
+	std::filesystem::remove(table);
+	{
+		CompressedVectorFile<int64_t, DeltaDeltaCodec<int64_t>> vec(p, true, 1024);
+		for (int64_t i = 0; i < 10000; i++)
+		{
+			vec.push_back(1700000000000 + i * 1000 + (i % 10 == 0 ? 1 : 0));
+		}
+		vec.flush();
+		EXPECT_LT(vec.size_file(), sizeof(int64_t) * 10000 / 20);
+		EXPECT_EQ(vec.get(9990), 1700000000000 + 9990 * 1000 + 1);
+	}
+	std::filesystem::remove(p);
+	std::filesystem::remove(table);
+}
+
+TEST(FileHeader, LogicalSizeAndValidation)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	for (StorageMode storage : { StorageMode::stream, StorageMode::mapped })
+	{
+		{
+			VectorFile<int> vec(p, sizeof(int) * 5000, 512, { .storage = storage, .windows = 2, .header = true });
+			EXPECT_EQ(vec.data_offset(), VectorFileHeader::size);
+			for (int i = 0; i < 5000; i++)
+			{
+				vec[i] = i;
+			}
+			vec.push_back(5000);
+			vec.resize(sizeof(int) * 3000);
+			EXPECT_EQ(vec.pop_back(), 2999);
+		}
+		EXPECT_GT(std::filesystem::file_size(p), VectorFileHeader::size + sizeof(int) * 2999);
+		{
+			VectorFile<int> vec(p, true, 0, { .storage = storage });
+			ASSERT_EQ(vec.size_file(), sizeof(int) * 2999);
+			EXPECT_EQ(vec.window_elements(), 128u);
+			EXPECT_EQ(vf::reduce(vec, 0ll, std::plus<>{}, 3), 2999ll * 2998 / 2);
+			vec.resize(sizeof(int) * 10000);
+			vec[9999] = -1;
+		}
+		{
+			VectorFile<int> vec(p, true, 256, { .storage = storage, .windows = 2, .prefetch = true, .write_behind = 2, .io_engine = IoEngineKind::uring });
+			for (int i = 0; i < 2999; i++)
+			{
+				ASSERT_EQ(vec[i], i);
+			}
+			vec[100] = 100;
+		}
+		{
+			VectorFile<int> vec(p);
+			ASSERT_EQ(vec.size_file(), sizeof(int) * 10000);
+			EXPECT_EQ(vec[2998], 2998);
+			EXPECT_EQ(vec[2999], 0);
+			EXPECT_EQ(vec[5000], 0);
+			EXPECT_EQ(vec[9999], -1);
+		}
+		EXPECT_THROW((VectorFile<float>(p)), format_mismatch);
+		EXPECT_THROW((VectorFile<int64_t>(p)), format_mismatch);
+		std::filesystem::remove(p);
+	}
+	{
+		VectorFile<Triple> vec(p, sizeof(Triple) * 100, sizeof(Triple) * 30, { .direct = true, .header = true });
+		for (int i = 0; i < 100; i++)
+		{
+			vec[i] = { i, i, i };
+		}
+		vec.push_back({ 100, 0, 0 });
+	}
+	{
+		VectorFile<Triple> vec(p, false, sizeof(Triple) * 30, { .direct = true });
+		ASSERT_EQ(vec.size_file(), sizeof(Triple) * 101);
+		EXPECT_EQ(vec[42].b, 42);
+		EXPECT_EQ(vec[100].a, 100);
+	}
+	std::filesystem::remove(p);
+}
+
+TEST(FileHeader, ReadOnlyCloseAndRegrowth)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	for (StorageMode storage : { StorageMode::stream, StorageMode::mapped })
+	{
+		{
+			VectorFile<int> vec(p, sizeof(int) * 2000, 1024, { .storage = storage, .header = true });
+			for (int i = 0; i < 2000; i++)
+			{
+				vec[i] = i + 1;
+			}
+		}
+		const auto physical = std::filesystem::file_size(p);
+		{
+			VectorFile<int> vec(p, false, 1024, { .storage = storage });
+			EXPECT_EQ(vec[1999], 2000);
+		}
+		EXPECT_EQ(std::filesystem::file_size(p), physical);
+		{
+			VectorFile<int> vec(p);
+			ASSERT_EQ(vec.size_file(), sizeof(int) * 2000);
+			EXPECT_EQ(vec[1999], 2000);
+		}
+		{
+			VectorFile<int> vec(p, true, 1024, { .storage = storage });
+			vec.resize(sizeof(int) * 8);
+			vec.resize(sizeof(int) * 64);
+		}
+		{
+			VectorFile<int> vec(p);
+			ASSERT_EQ(vec.size_file(), sizeof(int) * 64);
+			EXPECT_EQ(vec[7], 8);
+			EXPECT_EQ(vec[40], 0);
+			EXPECT_EQ(vec[63], 0);
+		}
+		{
+			VectorFile<int> vec(p, true, 1024, { .storage = storage });
+			vec.resize(sizeof(int) * 4);
+			vec.resize(sizeof(int) * 16);
+			vec.flush();
+			EXPECT_EQ(vec[10], 0);
+		}
+		{
+			VectorFile<int> vec(p);
+			ASSERT_EQ(vec.size_file(), sizeof(int) * 16);
+			EXPECT_EQ(vec[3], 4);
+			EXPECT_EQ(vec[10], 0);
+		}
+		std::filesystem::remove(p);
+	}
+}
+
+TEST(FileHeader, SharedAndConcurrentFiles)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	{
+		VectorFile<int> vec(p, sizeof(int) * 1000, 256, { .header = true });
+		for (int i = 0; i < 1000; i++)
+		{
+			vec[i] = i;
+		}
+		EXPECT_EQ(vec.pop_back(), 999);
+		EXPECT_EQ(vec.pop_back(), 998);
+	}
+	{
+		SharedVectorFile<int> shared(p);
+		EXPECT_EQ(shared.data_offset(), VectorFileHeader::size);
+		ASSERT_EQ(shared.size_file(), sizeof(int) * 998);
+		auto cursor = shared.cursor();
+		EXPECT_EQ(cursor[0], 0);
+		EXPECT_EQ(cursor[997], 997);
+		EXPECT_THROW(cursor[998], goind_out_of_file);
+		std::vector<int> range(10);
+		cursor.read_range(500, range);
+		EXPECT_EQ(range[9], 509);
+	}
+	{
+		ConcurrentVectorFile<int> vec(p, 256, 4, 8);
+		EXPECT_EQ(vec.data_offset(), VectorFileHeader::size);
+		ASSERT_EQ(vec.size_file(), sizeof(int) * 998);
+		EXPECT_EQ(vec.load(0), 0);
+		EXPECT_EQ(vec.load(997), 997);
+		vec.store(5, -5);
+		EXPECT_EQ(vec.push_back(-998), 998u);
+		EXPECT_EQ(vec.push_back(-999), 999u);
+		vec.flush();
+		vec.resize(sizeof(int) * 900);
+		vec.resize(sizeof(int) * 1100);
+		EXPECT_EQ(vec.load(950), 0);
+	}
+	{
+		VectorFile<int> vec(p);
+		EXPECT_EQ(vec.data_offset(), VectorFileHeader::size);
+		ASSERT_EQ(vec.size_file(), sizeof(int) * 1100);
+		EXPECT_EQ(vec[5], -5);
+		EXPECT_EQ(vec[899], 899);
+		EXPECT_EQ(vec[998], 0);
+		EXPECT_EQ(vec[1099], 0);
+	}
+	EXPECT_THROW((SharedVectorFile<float>(p)), format_mismatch);
+	EXPECT_THROW((ConcurrentVectorFile<int64_t>(p)), format_mismatch);
+	std::filesystem::remove(p);
+}
+
+TEST(Mapped, PushBackAfterPopBackRemapsTail)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	{
+		VectorFile<int> vec(p, sizeof(int) * 100, 256, { .storage = StorageMode::mapped, .windows = 2 });
+		for (int i = 0; i < 100; i++)
+		{
+			vec[i] = i;
+		}
+		EXPECT_EQ(vec.pop_back(), 99);
+		EXPECT_EQ(vec.pop_back(), 98);
+		vec.push_back(-98);
+		EXPECT_EQ(vec[97], 97);
+		EXPECT_EQ(vec[98], -98);
+		vec[10] = -10;
+	}
+	{
+		VectorFile<int> vec(p);
+		ASSERT_EQ(vec.size_file(), sizeof(int) * 99);
+		EXPECT_EQ(vec[10], -10);
+		EXPECT_EQ(vec[98], -98);
+	}
+	std::filesystem::remove(p);
+}
+
+TEST(Append, ThrowingIteratorKeepsPrefix)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	{
+		VectorFile<int> vec(p, sizeof(int) * 10, 64, { .append_buffer = sizeof(int) * 8 });
+		auto values = std::views::iota(10, 100) | std::views::transform([](int i)
+			{
+				if (i == 50)
+				{
+					throw std::runtime_error("iterator failed");
+				}
+				return i;
+			});
+		EXPECT_THROW(vec.append(values.begin(), values.end()), std::runtime_error);
+		ASSERT_EQ(vec.size_file(), sizeof(int) * 50);
+		EXPECT_EQ(vec[49], 49);
+		vec.push_back(50);
+		EXPECT_EQ(vec[50], 50);
+		EXPECT_EQ(vec[20], 20);
+	}
+	{
+		VectorFile<int> vec(p);
+		ASSERT_EQ(vec.size_file(), sizeof(int) * 51);
+		for (int i = 10; i < 51; i++)
+		{
+			ASSERT_EQ(vec[i], i);
+		}
+	}
+	std::filesystem::remove(p);
+}
+
+TEST(Checksums, Crc32c)
+{
+	const char check[] = "123456789";
+	EXPECT_EQ(crc32c(check, 9), 0xE3069283u);
+	EXPECT_EQ(crc32c_portable(check, 9), 0xE3069283u);
+	EXPECT_EQ(crc32c(check + 4, 5, crc32c(check, 4)), 0xE3069283u);
+
+	std::mt19937 gen(7);
+	std::vector<unsigned char> bytes(4096);
+	for (unsigned char& byte : bytes)
+	{
+		byte = static_cast<unsigned char>(gen());
+	}
+	for (int i = 0; i < 200; i++)
+	{
+		const size_t first = gen() % 64;
+		const size_t length = gen() % (bytes.size() - first);
+		ASSERT_EQ(crc32c(bytes.data() + first, length), crc32c_portable(bytes.data() + first, length));
+	}
+}
+
+TEST(Checksums, VerifiedOnLoad)
+{
+	auto p = std::filesystem::temp_directory_path() / "temp.bin";
+	auto table = p;
+	table += ".crc";
+	{
+		VectorFile<int> vec(p, sizeof(int) * 1000, 256, { .windows = 2, .checksums = true });
+		for (int i = 0; i < 1000; i++)
+		{
+			vec[i] = i;
+		}
+		for (int i = 1000; i < 1100; i++)
+		{
+			vec.push_back(i);
+		}
+		EXPECT_EQ(vec.pop_back(), 1099);
+		vec.push_back(-1);
+	}
+	EXPECT_TRUE(std::filesystem::exists(table));
+	{
+		VectorFile<int> vec(p, true, 256, { .windows = 2, .prefetch = true, .write_behind = 2, .io_engine = IoEngineKind::uring, .checksums = true });
+		for (int i = 0; i < 1099; i++)
+		{
+			ASSERT_EQ(vec[i], i);
+			vec[i] = -i;
+		}
+		std::vector<int> range(10, 7);
+		vec.write_range(500, range);
+		vec.resize(sizeof(int) * 900);
+		vec.push_back(900);
+	}
+	{
+		VectorFile<int> vec(p, false, 256, { .prefetch = true, .checksums = true });
+		ASSERT_EQ(vec.size_file(), sizeof(int) * 901);
+		for (int i = 0; i < 900; i++)
+		{
+			ASSERT_EQ(vec[i], i >= 500 && i < 510 ? 7 : -i);
+		}
+		EXPECT_EQ(vec[900], 900);
+	}
+	overwrite_in_file(p, sizeof(int) * 300, 12345);
+	{
+		VectorFile<int> vec(p, false, 256, { .windows = 2, .checksums = true });
+		EXPECT_EQ(vec[10], -10);
+		EXPECT_THROW(vec[300], checksum_error);
+		EXPECT_EQ(vec[700], -700);
+		EXPECT_THROW(vec[301], checksum_error);
+	}
+	{
+		VectorFile<int> vec(p);
+		EXPECT_EQ(vec[300], 12345);
+	}
+	for (bool header : { false, true })
+	{
+		{
+			VectorFile<int> vec(p, sizeof(int) * 64, 64, { .header = header, .checksums = true });
+			for (int i = 0; i < 64; i++)
+			{
+				vec[i] = i + 1;
+			}
+		}
+		{
+			VectorFile<int> vec(p, true, 64, { .checksums = true });
+			EXPECT_EQ(vec.get(40), 41);
+			vec.resize(sizeof(int) * 8);
+			vec.resize(sizeof(int) * 64);
+		}
+		{
+			VectorFile<int> vec(p, false, 64, { .checksums = true });
+			EXPECT_EQ(vec.get(7), 8);
+			EXPECT_EQ(vec.get(40), 0);
+		}
+		{
+			VectorFile<int> vec(p, true, 64, { .checksums = true });
+			vec.resize(sizeof(int) * 4);
+			vec.resize(sizeof(int) * 32);
+			vec.flush();
+		}
+		{
+			VectorFile<int> vec(p, false, 64, { .checksums = true });
+			EXPECT_EQ(vec.get(3), 4);
+			EXPECT_EQ(vec.get(20), 0);
+		}
+	}
+	EXPECT_THROW((VectorFile<int>(p, false, 256, { .storage = StorageMode::mapped, .checksums = true })), unsupported_storage);
+	{
+		VectorFile<int> vec(p, true);
+	}
+	EXPECT_FALSE(std::filesystem::exists(table));
+	std::filesystem::remove(p);
+}
+
 //TEST(Iterator, Test1)
 //{
 //	auto p = std::filesystem::current_path() / "temp.bin";
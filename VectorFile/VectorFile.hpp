@@ -3,6 +3,19 @@
 #include <vector>
 #include <filesystem>
 #include <iterator>
+#include <span>
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+#include <memory>
+#include <bit>
+#include <cstdint>
+#include <numeric>
+#include "file_handle.hpp"
+#include "io_engine.hpp"
+#include "crc32c.hpp"
+#include "window_prefetcher.hpp"
+#include "window_writer.hpp"
 #include "vector_file_exception.hpp"
 
 
@@ -23,6 +36,26 @@ struct Serializer
 	{
 		return sizeof(T);
 	}
+
+	// : sizeof(T)   ,      
+	static void serialization(std::span<const T> elems, std::span<char> bytes) requires std::is_trivially_copyable_v<T>
+	{
+		std::memcpy(bytes.data(), elems.data(), elems.size_bytes());
+	}
+
+	static void deserialization(std::span<const char> bytes, std::span<T> elems) requires std::is_trivially_copyable_v<T>
+	{
+		std::memcpy(elems.data(), bytes.data(), elems.size_bytes());
+	}
+};
+
+//   ,         .
+//     sizeof(T) .
+template <typename S, typename T>
+concept BulkSerializer = requires(std::span<const T> elems, std::span<T> out, std::span<char> bytes, std::span<const char> cbytes)
+{
+	S::serialization(elems, bytes);
+	S::deserialization(cbytes, out);
 };
 
 //template <typename T>
@@ -38,23 +71,181 @@ concept Acceptable = std::is_move_constructible_v<T> && !std::is_const_v<T>;
 //	T::deserialization(std::declval<Args>() ...);
 //};
 
-template <Acceptable T, class S = Serializer<T>>
+enum class StorageMode
+{
+	stream,		//      
+	mapped		//    (      Serializer<T>)
+};
+
+enum class GrowthPolicy
+{
+	sparse,		//   ftruncate,      
+	allocate,	//    posix_fallocate
+	zero_fill	//   
+};
+
+struct VectorFileOptions
+{
+	StorageMode storage = StorageMode::stream;
+	GrowthPolicy growth = GrowthPolicy::sparse;
+	size_t windows = 1;		//    (LRU)
+	bool prefetch = false;	//      
+	size_t write_behind = 0;	//     , 0 -   
+	size_t append_buffer = 1 << 20;	//   push_back ()
+	bool direct = false;	// -     ( ,  );     
+	IoEngineKind io_engine = IoEngineKind::positional;	//  -,      ( ,  )
+	bool header = false;	//    (VectorFileHeader);     
+	bool checksums = false;	//CRC32C   <path>.crc:    ,    ( ,  )
+};
+
+//  .     (4096 ),    .
+//  ,       pop_back/resize.
+struct VectorFileHeader
+{
+	static constexpr char signature[8] = { 'V', 'E', 'C', 'F', 'I', 'L', 'E', '\0' };
+	static constexpr uint32_t current_version = 1;
+	static constexpr size_t size = 4096;	//      ()
+
+	char magic[8];			//signature
+	uint32_t version;		// 
+	uint32_t flags;			//, 0
+	uint64_t type_size;		//sizeof(T)
+	uint64_t fingerprint;	//   
+	uint64_t count;			// 
+	uint64_t window_size;	//    () -     window_size = 0
+	uint32_t codec;			// , 0 -  
+	uint32_t reserved;		//0
+
+	// : , ,      
+	template <class T, class S>
+	static constexpr uint64_t type_fingerprint() noexcept
+	{
+		return uint64_t(sizeof(T)) | uint64_t(alignof(T)) << 32 | uint64_t(std::is_integral_v<T>) << 48 | uint64_t(std::is_floating_point_v<T>) << 49
+			| uint64_t(std::is_signed_v<T>) << 50 | uint64_t(std::is_trivially_copyable_v<T>) << 51
+			| uint64_t(std::is_trivially_copyable_v<T> && std::is_same_v<S, Serializer<T>>) << 52;
+	}
+
+	//      T   S. false -  ;
+	//format_mismatch -     ,     .
+	template <class T, class S>
+	static bool read(const FileHandle& handle, VectorFileHeader& header)
+	{
+		if (handle.size() < size)
+		{
+			return false;
+		}
+		handle.read_at(0, &header, sizeof(header));
+		if (std::memcmp(header.magic, signature, sizeof(header.magic)) != 0)
+		{
+			return false;
+		}
+		if (header.version > current_version || header.type_size != sizeof(T) || header.fingerprint != type_fingerprint<T, S>() || header.codec != 0)
+		{
+			throw format_mismatch();
+		}
+		return true;
+	}
+
+	template <class T, class S>
+	static void write(FileHandle& handle, uint64_t count, uint64_t window_size)
+	{
+		VectorFileHeader header{};
+		std::memcpy(header.magic, signature, sizeof(header.magic));
+		header.version = current_version;
+		header.type_size = sizeof(T);
+		header.fingerprint = type_fingerprint<T, S>();
+		header.count = count;
+		header.window_size = window_size;
+		std::vector<char> block(size);
+		std::memcpy(block.data(), &header, sizeof(header));
+		handle.write_at(0, block.data(), block.size());
+	}
+};
+
+//WindowElems -    ,    ( ):      
+//   ,   window_size   . 0 -    .
+template <Acceptable T, class S = Serializer<T>, size_t WindowElems = 0>
 class VectorFile final
 {
+	static_assert(WindowElems == 0 || std::has_single_bit(WindowElems), "WindowElems must be a power of two");
+
 	static const size_t type_size_ = sizeof(T);	//  ()
+	static constexpr bool fixed_window_ = WindowElems != 0;
+	static constexpr int window_shift_ = fixed_window_ ? std::countr_zero(WindowElems) : 0;
+	static constexpr bool mappable_ = std::is_trivially_copyable_v<T> && std::is_same_v<S, Serializer<T>>;
+	static constexpr bool bulk_ = BulkSerializer<S, T>;
+	static constexpr size_t zero_chunk_size_ = 1 << 20;	//    GrowthPolicy::zero_fill ()
+	static constexpr size_t io_chunk_ = 1 << 20;		//     - ()
+	static constexpr size_t no_page_ = static_cast<size_t>(-1);
+
+	struct Window
+	{
+		size_t page = no_page_;		//  ,   
+		size_t offset = 0;			//    ()
+		WindowBuffer<T> buffer;		//  
+		MappedView view;			// 
+		size_t count = 0;			//   
+		size_t dirty_first = 0;		//    ()
+		size_t dirty_last = 0;		//    (,  )
+		size_t last_use = 0;		//   ( LRU)
+		size_t pins = 0;			// ,  
+	};
+
+	struct PageChecksum
+	{
+		uint32_t crc;		//CRC32C  
+		uint32_t count;		// ,    ; 0 -  
+	};
+
 	bool is_write_;							// -/
+	StorageMode storage_;					//  
+	GrowthPolicy growth_;					//  
 	std::fstream file_;						//
 	std::filesystem::path path_;			//  
 	size_t file_size_;						//   ()
 	size_t target_file_size_;				//   ()
+	size_t data_offset_ = 0;				//    :    0 ()
 	size_t target_window_size_;				//  ()
-	size_t offset_window_;					//    ()
-	std::vector<T> buffer_;					//  
+	size_t window_elems_;					//  ()
+	std::vector<Window> windows_;			// 
+	std::unordered_map<size_t, size_t> pages_;	//  ->    
+	size_t current_ = 0;					//  
+	size_t current_first_ = 0;				//    
+	size_t current_count_ = 0;				//   
+	T* current_data_ = nullptr;				//  
+	size_t clock_ = 0;						//   LRU
+	size_t hits_ = 0;						//   
+	size_t misses_ = 0;						//  
+	size_t last_page_ = no_page_;			//   (   )
+	bool prefetch_;							// 
+	size_t prefetch_hits_ = 0;				//,    
+	std::vector<T> append_;					// push_back,     
+	size_t append_offset_ = 0;				//     ()
+	size_t append_capacity_;				//   ()
+	FileHandle handle_;						//   -  
+	std::vector<char> bytes_;				//   
+	FileHandle direct_;						//  - (    direct)
+	AlignedBuffer aligned_;					//   -
+	size_t direct_unit_ = 1;				// direct:   ,   
+	AlignedAllocator<T> window_allocator_;	//   (  direct -   )
+	std::unique_ptr<WindowPrefetcher<T, S, mappable_>> prefetcher_;	//  ( ,  )
+	std::unique_ptr<WindowWriter<T, S, mappable_>> writer_;			//  ( ,  )
+	std::unique_ptr<IoEngine> engine_;		// -  (    )
+	std::vector<IoRequest> requests_;		//   
+	std::vector<std::vector<char>> staging_;	//   flush ( )
+	std::filesystem::path checksum_path_;	//   <path>.crc (,    )
+	std::vector<PageChecksum> checksums_;	//  
+	bool checksums_dirty_ = false;			// 
 
 public:
-	explicit VectorFile(std::filesystem::path path, bool is_write = false, size_t window_size = 1024)
-		: is_write_(is_write), path_(std::move(path)), target_window_size_(window_size), offset_window_(0)
+	explicit VectorFile(std::filesystem::path path, bool is_write = false, size_t window_size = 1024, VectorFileOptions options = {})
+		: is_write_(is_write), storage_(options.storage), growth_(options.growth), path_(std::move(path)), target_window_size_(window_size), prefetch_(options.prefetch)
 	{
+		if ((storage_ == StorageMode::mapped && !mappable_) || ((options.direct || options.checksums) && (storage_ == StorageMode::mapped || !bulk_)))
+		{
+			throw unsupported_storage();
+		}
+
 		std::ios_base::openmode flags;
 		if (is_write_) {
 			flags = std::ios::in | std::ios::out | std::ios::binary;
@@ -67,43 +258,53 @@ public:
 		if (!file_.is_open()) {
 			throw std::runtime_error("File does not exist or could not be opened for reading.");
 		}
+		handle_ = FileHandle(path_, is_write_);
 
-		file_size_ = get_size_file();
-		target_file_size_ = file_size_;
+		if (read_header())
+		{
+			file_size_ = std::min(align_filesize_to_typesize(handle_.size() - data_offset_), target_file_size_);
+		}
+		else
+		{
+			file_size_ = get_size_file();
+			target_file_size_ = file_size_;
+		}
 
-		read();
+		init_windows(options);
 	}
 
-	explicit VectorFile(std::filesystem::path path, size_t file_size, size_t window_size = 1024)
-		: is_write_(true), path_(std::move(path)), file_size_(0), target_window_size_(window_size), offset_window_(0)
+	explicit VectorFile(std::filesystem::path path, size_t file_size, size_t window_size = 1024, VectorFileOptions options = {})
+		: is_write_(true), storage_(options.storage), growth_(options.growth), path_(std::move(path)), file_size_(0), target_window_size_(window_size), prefetch_(options.prefetch)
 	{
+		if ((storage_ == StorageMode::mapped && !mappable_) || ((options.direct || options.checksums) && (storage_ == StorageMode::mapped || !bulk_)))
+		{
+			throw unsupported_storage();
+		}
 		target_file_size_ = align_filesize_to_typesize(file_size);
 
 		file_.open(path_, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+		handle_ = FileHandle(path_, is_write_);
+		std::filesystem::remove(checksum_file());
+		if (options.header)
+		{
+			data_offset_ = VectorFileHeader::size;
+			write_header();
+		}
 
 		const size_t count_elem_for_filling = target_file_size_ > target_window_size_ ? target_window_size_ / type_size_ : target_file_size_ / type_size_;
 		filling(count_elem_for_filling);
-		read();
+		init_windows(options);
 	}
 
+	//       ;   ,   flush()  
 	~VectorFile()
 	{
-		if (!file_.is_open())
-		{
-			return;
-		}
-		if (is_write_)
-		{
-			write();
-		}
-		if (target_file_size_ > file_size_)
+		try
 		{
-			filling((target_file_size_ - file_size_) / type_size_);
+			close();
 		}
-		if (file_size(path_) > target_file_size_)
+		catch (...)
 		{
-			file_.close();
-			resize_file(path_, target_file_size_);
 		}
 	}
 
@@ -114,7 +315,7 @@ public:
 
 	size_t size_buffer() const noexcept
 	{
-		return buffer_.size();
+		return size(windows_[current_]);
 	}
 
 	size_t size_file() const noexcept
@@ -122,69 +323,428 @@ public:
 		return target_file_size_;
 	}
 
+	bool writable() const noexcept
+	{
+		return is_write_;
+	}
+
+	const std::filesystem::path& path() const noexcept
+	{
+		return path_;
+	}
+
+	//    :    0 ()
+	size_t data_offset() const noexcept
+	{
+		return data_offset_;
+	}
+
+	size_t cache_hits() const noexcept
+	{
+		return hits_;
+	}
+
+	size_t cache_misses() const noexcept
+	{
+		return misses_;
+	}
+
+	size_t prefetch_hits() const noexcept
+	{
+		return prefetch_hits_;
+	}
+
+	//   ,   amount_elements.    .
 	void seek_window(size_t amount_elements)
 	{
 		if (amount_elements * type_size_ >= target_file_size_)
 		{
 			throw goind_out_of_file();
 		}
-		if (amount_elements * type_size_ >= file_size_)
+		flush_append();
+		const size_t page = page_of(amount_elements);
+		const size_t page_end = std::min(page_first(page + 1) * type_size_, target_file_size_);
+		if (page_end > file_size_)
+		{
+			filling((page_end - file_size_) / type_size_);
+		}
+
+		const auto found = pages_.find(page);
+		const size_t slot = found != pages_.end() ? found->second : victim();
+		Window& window = windows_[slot];
+		if (window.pins > 0)
 		{
-			const size_t count_elem_for_filling = amount_elements * type_size_ + target_window_size_ < target_file_size_ ? amount_elements * type_size_ - file_size_ + target_window_size_ : target_file_size_ - file_size_;
-			filling(count_elem_for_filling);
+			throw window_pinned();
 		}
 		if (is_write_)
 		{
-			write();
+			evict(window);
+		}
+		pages_.erase(window.page);
+		read(window, page);
+		pages_.emplace(page, slot);
+		current_ = slot;
+		cache_current();
+		window.last_use = ++clock_;
+
+		if (prefetch_ && page == last_page_ + 1)
+		{
+			prefetch(page + 1);
 		}
-		offset_window_ = static_cast<off_t>(amount_elements * type_size_);
-		read();
+		last_page_ = page;
 	}
 
+	//  :           flush()
 	T& operator[](size_t index)
 	{
-		if (index < 0 || target_file_size_ / type_size_ <= index)
+		return locate(index, true);
+	}
+
+	//  :    
+	const T& get(size_t index)
+	{
+		return locate(index, false);
+	}
+
+	//   .   ,  :   ,   ,
+	//    ,  window_pinned.     pop_back, resize  refresh.
+	template <class E>
+	class WindowView
+	{
+		VectorFile* vector_;	//,   
+		size_t slot_;			//   
+		std::span<E> span_;		// 
+
+		WindowView(VectorFile* vector, size_t slot, std::span<E> span) : vector_(vector), slot_(slot), span_(span) {}
+
+	public:
+		friend class VectorFile;
+
+		WindowView(WindowView&& other) noexcept : vector_(std::exchange(other.vector_, nullptr)), slot_(other.slot_), span_(other.span_) {}
+		WindowView& operator=(WindowView&&) = delete;
+		WindowView(const WindowView&) = delete;
+		WindowView& operator=(const WindowView&) = delete;
+
+		~WindowView()
+		{
+			if (vector_)
+			{
+				--vector_->windows_[slot_].pins;
+			}
+		}
+
+		std::span<E> span() const noexcept
+		{
+			return span_;
+		}
+
+		E* data() const noexcept
+		{
+			return span_.data();
+		}
+
+		size_t size() const noexcept
+		{
+			return span_.size();
+		}
+
+		E* begin() const noexcept
+		{
+			return span_.data();
+		}
+
+		E* end() const noexcept
+		{
+			return span_.data() + span_.size();
+		}
+
+		E& operator[](size_t index) const noexcept
+		{
+			return span_[index];
+		}
+	};
+
+	// [first, first + count)  :    .
+	//    ,      count.
+	WindowView<T> window_view(size_t first, size_t count)
+	{
+		const auto [slot, length] = pin(first, count);
+		Window& window = windows_[slot];
+		const size_t position = first - page_first(window.page);
+		if (length > 0)
+		{
+			mark_dirty(window, position);
+			mark_dirty(window, position + length - 1);
+		}
+		return WindowView<T>(this, slot, std::span<T>(data(window) + position, length));
+	}
+
+	//  :    
+	WindowView<const T> read_view(size_t first, size_t count)
+	{
+		const auto [slot, length] = pin(first, count);
+		Window& window = windows_[slot];
+		const size_t position = first - page_first(window.page);
+		return WindowView<const T>(this, slot, std::span<const T>(data(window) + position, length));
+	}
+
+	size_t window_elements() const noexcept
+	{
+		return window_elems();
+	}
+
+	bool in_window(size_t index) const noexcept
+	{
+		return index - current_first_ < current_count_;
+	}
+
+	//        .  : in_window(index).
+	//   ;       window_view.
+	const T& at_unchecked(size_t index) const noexcept
+	{
+		return current_data_[index - current_first_];
+	}
+
+	//  [first, first + out.size())     ,  .
+	//,            .
+	void read_range(size_t first, std::span<T> out)
+	{
+		const size_t end = first + out.size();
+		if (end * type_size_ > target_file_size_)
 		{
 			throw goind_out_of_file();
 		}
-		const size_t index_first_elem = offset_window_ / type_size_;
-		const size_t window_space = target_file_size_ - offset_window_ >= target_window_size_ ? target_window_size_ : target_file_size_ - offset_window_;
-		if (index_first_elem <= index && index <= index_first_elem + window_space - 1)
+		const size_t file_end = append_.empty() ? end : std::min(end, append_offset_ / type_size_);
+		if (first < file_end)
+		{
+			if (file_end * type_size_ > file_size_)
+			{
+				filling((file_end * type_size_ - file_size_) / type_size_);
+			}
+			const size_t count = file_end - first;
+			if (storage_ == StorageMode::mapped)
+			{
+				handle_.read_at(data_offset_ + first * type_size_, out.data(), count * type_size_);
+			}
+			else if constexpr (bulk_)
+			{
+				read_block(first * type_size_, out.data(), count);
+			}
+			else
+			{
+				file_.clear();
+				file_.seekg(data_offset_ + first * type_size_, std::ios::beg);
+				for (size_t i = 0; i < count; i++)
+				{
+					S::deserialization(file_, out[i]);
+				}
+			}
+			for (Window& window : windows_)
+			{
+				const size_t base = window.offset / type_size_;
+				if (window.page == no_page_ || window.dirty_first >= window.dirty_last)
+				{
+					continue;
+				}
+				const size_t from = std::max(first, base + window.dirty_first);
+				const size_t to = std::min(file_end, base + window.dirty_last);
+				if (from < to)
+				{
+					std::copy(data(window) + (from - base), data(window) + (to - base), out.begin() + (from - first));
+				}
+			}
+		}
+		if (file_end < end)
 		{
-			return buffer_[index - index_first_elem];
+			const size_t from = std::max(first, file_end);
+			const size_t base = append_offset_ / type_size_;
+			std::copy(append_.begin() + (from - base), append_.begin() + (end - base), out.begin() + (from - first));
 		}
-		seek_window(index);
-		return buffer_[0];
 	}
 
-	void flush()
+	//  [first, first + in.size())     ,  .
+	//     ;        .
+	void write_range(size_t first, std::span<const T> in)
 	{
 		if (!is_write_)
 		{
 			throw write_error();
 		}
-		write();
+		const size_t end = first + in.size();
+		if (end * type_size_ > target_file_size_)
+		{
+			throw goind_out_of_file();
+		}
+		const size_t file_end = append_.empty() ? end : std::min(end, append_offset_ / type_size_);
+		if (first < file_end)
+		{
+			if (prefetcher_)
+			{
+				prefetcher_->cancel();
+			}
+			if (file_end * type_size_ > file_size_)
+			{
+				filling((file_end * type_size_ - file_size_) / type_size_);
+			}
+			const size_t count = file_end - first;
+			invalidate(first, file_end);
+			if (storage_ == StorageMode::mapped)
+			{
+				handle_.write_at(data_offset_ + first * type_size_, in.data(), count * type_size_);
+			}
+			else if constexpr (bulk_)
+			{
+				write_block(first * type_size_, in.data(), count);
+			}
+			else
+			{
+				file_.clear();
+				file_.seekp(data_offset_ + first * type_size_, std::ios::beg);
+				for (T elem : in.first(count))
+				{
+					S::serialization(file_, elem);
+				}
+				file_.flush();
+			}
+			for (Window& window : windows_)
+			{
+				const size_t base = window.offset / type_size_;
+				if (window.page == no_page_)
+				{
+					continue;
+				}
+				const size_t from = std::max(first, base);
+				const size_t to = std::min(file_end, base + size(window));
+				if (from < to)
+				{
+					std::copy(in.begin() + (from - first), in.begin() + (to - first), data(window) + (from - base));
+				}
+			}
+		}
+		if (file_end < end)
+		{
+			const size_t from = std::max(first, file_end);
+			const size_t base = append_offset_ / type_size_;
+			std::copy(in.begin() + (from - first), in.end(), append_.begin() + (from - base));
+		}
 	}
 
-	void push_back(const T& value)
+	void flush()
 	{
 		if (!is_write_)
 		{
 			throw write_error();
 		}
-		if (buffer_.size() < target_window_size_ / type_size_)
+		flush_append();
+		if (writer_)
+		{
+			writer_->drain();
+		}
+		if (storage_ == StorageMode::mapped)
+		{
+			for (Window& window : windows_)
+			{
+				window.view.sync();
+			}
+		}
+		else
+		{
+			write_windows();
+		}
+		file_.flush();
+		if (data_offset_ > 0)
 		{
-			buffer_.push_back(value);
+			close_with_header();
 		}
-		if (target_file_size_ - file_size_ > 0)
+		else if (target_file_size_ > file_size_)
 		{
 			filling((target_file_size_ - file_size_) / type_size_);
 		}
-		file_.clear();
-		file_.seekp(target_file_size_, std::ios::beg);
-		file_.write(reinterpret_cast<const char*>(&value), type_size_);
+		save_checksums();
+		file_.flush();
+	}
+
+	//           (   ).
+	// ,   flush(), .
+	void refresh()
+	{
+		if (prefetcher_)
+		{
+			prefetcher_->cancel();
+		}
+		for (PageChecksum& entry : checksums_)
+		{
+			entry.count = 0;
+		}
+		for (Window& window : windows_)
+		{
+			if (window.page != no_page_)
+			{
+				read(window, window.page);
+			}
+		}
+		cache_current();
+	}
+
+	//           ,  , flush()   
+	void push_back(const T& value)
+	{
+		if (!is_write_)
+		{
+			throw write_error();
+		}
+		if (append_.empty())
+		{
+			append_offset_ = target_file_size_;
+			append_.reserve(append_capacity_);
+		}
+		append_.push_back(value);
 		target_file_size_ += type_size_;
-		file_size_ += type_size_;
+		if (append_.size() >= append_capacity_)
+		{
+			flush_append();
+		}
+	}
+
+	//  . ,     ,     .
+	void append(std::span<const T> values)
+	{
+		append(values.begin(), values.end());
+	}
+
+	template <std::input_iterator It, std::sentinel_for<It> End>
+	void append(It first, End last)
+	{
+		if (!is_write_)
+		{
+			throw write_error();
+		}
+		if constexpr (bulk_ && std::contiguous_iterator<It> && std::sized_sentinel_for<End, It>)
+		{
+			const size_t count = static_cast<size_t>(last - first);
+			if (append_.size() + count > append_capacity_)
+			{
+				flush_append();
+				write_tail(target_file_size_, std::to_address(first), count);
+				target_file_size_ += count * type_size_;
+				return;
+			}
+		}
+		//     :           
+		for (; first != last; ++first)
+		{
+			if (append_.empty())
+			{
+				append_offset_ = target_file_size_;
+				append_.reserve(append_capacity_);
+			}
+			append_.push_back(*first);
+			target_file_size_ += type_size_;
+			if (append_.size() >= append_capacity_)
+			{
+				flush_append();
+			}
+		}
 	}
 
 	T pop_back() {
@@ -197,127 +757,1001 @@ public:
 		{
 			throw goind_out_of_file();
 		}
-		if (target_file_size_ - offset_window_ <= target_window_size_ && buffer_.size() <= (target_file_size_ - offset_window_) / type_size_)
+		if (!append_.empty())
 		{
-			buffer_.pop_back();
+			obj = std::move(append_.back());
+			append_.pop_back();
+			target_file_size_ -= type_size_;
+			return obj;
 		}
-		if (target_file_size_ - file_size_ > 0)
+		if (target_file_size_ > file_size_)
 		{
 			filling((target_file_size_ - file_size_) / type_size_);
 		}
-		file_.clear();
-		file_.seekg(target_file_size_ - type_size_, std::ios::beg);
-		file_.read(reinterpret_cast<char*>(&obj), type_size_);
+		const size_t tail = target_file_size_ - type_size_;
+		const auto found = pages_.find(page_of(tail / type_size_));
+		if (found != pages_.end() && windows_[found->second].offset + size(windows_[found->second]) * type_size_ == target_file_size_)
+		{
+			Window& window = windows_[found->second];
+			obj = std::move(data(window)[size(window) - 1]);
+			truncate(window, size(window) - 1);
+		}
+		else if constexpr (bulk_)
+		{
+			read_block(tail, &obj, 1);
+		}
+		else
+		{
+			file_.clear();
+			file_.seekg(data_offset_ + tail, std::ios::beg);
+			file_.read(reinterpret_cast<char*>(&obj), type_size_);
+		}
 		target_file_size_ -= type_size_;
 		file_size_ -= type_size_;
+		if (prefetcher_)
+		{
+			prefetcher_->cancel();
+		}
 
 		return obj;
 	}
 
 	void resize(size_t new_file_size)
 	{
+		flush_append();
 		size_t old_file_size = target_file_size_;
 		target_file_size_ = align_filesize_to_typesize(new_file_size);
 
-		if (new_file_size >= old_file_size)
+		if (target_file_size_ >= old_file_size)
 		{
 			return;
 		}
-		if (file_size_ > new_file_size)
+		if (file_size_ > target_file_size_)
+		{
+			file_size_ = target_file_size_;
+		}
+		if (prefetcher_)
+		{
+			prefetcher_->cancel();
+		}
+		if (writer_)
+		{
+			writer_->drain();
+		}
+		for (Window& window : windows_)
 		{
-			file_size_ = new_file_size;
+			if (window.page == no_page_ || window.offset + size(window) * type_size_ <= target_file_size_)
+			{
+				continue;
+			}
+			truncate(window, window.offset < target_file_size_ ? (target_file_size_ - window.offset) / type_size_ : 0);
 		}
 	}
 
-	class FileIterator
+	//  .     :  operator[],   Const -  get().
+	// ,      .      (std::sort,
+	//std::iter_swap),  begin()/end()   ,    .    LRU 
+	//      . Const     ( vector<bool>),
+	//       .
+	template <bool Const>
+	class BasicIterator
 	{
-		std::fstream& file_;
-		size_t pos_;
+		VectorFile* vector_ = nullptr;	//,    
+		size_t pos_ = 0;				// 
 
-		FileIterator(std::fstream& file, size_t pos) : file_(file), pos_(pos) {}
+		BasicIterator(VectorFile* vector, size_t pos) : vector_(vector), pos_(pos) {}
 
 	public:
 		friend class VectorFile;
 
-		using iterator_category = std::input_iterator_tag;
+		using iterator_category = std::random_access_iterator_tag;
+		using iterator_concept = std::random_access_iterator_tag;
 		using value_type = T;
 		using difference_type = std::ptrdiff_t;
-		using pointer = T*;
-		using reference = T&;
+		using pointer = std::conditional_t<Const, void, T*>;
+		using reference = std::conditional_t<Const, T, T&>;
+
+		BasicIterator() = default;
+
+		operator BasicIterator<true>() const requires (!Const)
+		{
+			return BasicIterator<true>(vector_, pos_);
+		}
+
+		reference operator*() const
+		{
+			if constexpr (Const)
+			{
+				return vector_->get(pos_);
+			}
+			else
+			{
+				return (*vector_)[pos_];
+			}
+		}
+
+		pointer operator->() const requires (!Const)
+		{
+			return &**this;
+		}
+
+		reference operator[](difference_type n) const
+		{
+			return *(*this + n);
+		}
+
+		BasicIterator& operator++()
+		{
+			++pos_;
+			return *this;
+		}
+
+		BasicIterator operator++(int)
+		{
+			BasicIterator old = *this;
+			++pos_;
+			return old;
+		}
+
+		BasicIterator& operator--()
+		{
+			--pos_;
+			return *this;
+		}
+
+		BasicIterator operator--(int)
+		{
+			BasicIterator old = *this;
+			--pos_;
+			return old;
+		}
 
-		bool operator!=(const FileIterator& other) const
+		BasicIterator& operator+=(difference_type n)
 		{
-			return pos_ != other.pos_;
+			pos_ += n;
+			return *this;
 		}
 
-		FileIterator& operator++()
+		BasicIterator& operator-=(difference_type n)
 		{
-			pos_ += S::get_size_element(file_);
+			pos_ -= n;
 			return *this;
 		}
 
-		T operator*()
+		friend BasicIterator operator+(BasicIterator iter, difference_type n)
+		{
+			return iter += n;
+		}
+
+		friend BasicIterator operator+(difference_type n, BasicIterator iter)
 		{
-			file_.seekg(pos_);
-			T value;
-			S::deserialization(file_, value);
-			return value;
+			return iter += n;
+		}
+
+		friend BasicIterator operator-(BasicIterator iter, difference_type n)
+		{
+			return iter -= n;
+		}
+
+		friend difference_type operator-(const BasicIterator& left, const BasicIterator& right)
+		{
+			return static_cast<difference_type>(left.pos_) - static_cast<difference_type>(right.pos_);
+		}
+
+		bool operator==(const BasicIterator& other) const
+		{
+			return pos_ == other.pos_;
+		}
+
+		auto operator<=>(const BasicIterator& other) const
+		{
+			return pos_ <=> other.pos_;
 		}
 	};
 
+	using FileIterator = BasicIterator<false>;
+	using ConstFileIterator = BasicIterator<true>;
+
 	FileIterator begin()
 	{
-		return FileIterator(file_, 0);
+		reserve_iterator_windows();
+		return FileIterator(this, 0);
 	}
 
 	FileIterator end()
 	{
-		return FileIterator(file_, file_size_);
+		reserve_iterator_windows();
+		return FileIterator(this, target_file_size_ / type_size_);
 	}
 
-	const FileIterator begin() const
+	//   :    .      ,  
+	//   .
+	ConstFileIterator cbegin()
 	{
-		return FileIterator(file_, 0);
+		return ConstFileIterator(this, 0);
 	}
 
-	const FileIterator end() const
+	ConstFileIterator cend()
 	{
-		return FileIterator(file_, file_size_);
+		return ConstFileIterator(this, target_file_size_ / type_size_);
 	}
 
 
+
 private:
-	void default_serialization(std::fstream file_, T elem)
+	//       (. BasicIterator)
+	void reserve_iterator_windows()
 	{
-		file_.write(reinterpret_cast<char*>(&elem), type_size_);
+		add_windows(2);
 	}
 
-	void read()
+	//   count ;      window_allocator_
+	void add_windows(size_t count)
 	{
-		buffer_.clear();
-		const size_t number_elem = file_size_ - offset_window_ >= target_window_size_ ? target_window_size_ / type_size_ : (file_size_ - offset_window_) / type_size_;
+		while (windows_.size() < count)
+		{
+			windows_.emplace_back().buffer = WindowBuffer<T>(window_allocator_);
+		}
+	}
+
+	//    ,     
+	void close()
+	{
+		if (!file_.is_open())
+		{
+			return;
+		}
+		prefetcher_.reset();
+		if (!is_write_)
+		{
+			//,   ,  
+			return;
+		}
+		flush_append();
+		writer_.reset();
+		if (storage_ == StorageMode::mapped)
+		{
+			windows_.clear();
+			if (data_offset_ > 0)
+			{
+				close_with_header();
+				return;
+			}
+			if (target_file_size_ > file_size_)
+			{
+				filling((target_file_size_ - file_size_) / type_size_);
+			}
+			if (handle_.size() > target_file_size_)
+			{
+				handle_.resize(target_file_size_);
+			}
+			return;
+		}
+		write_windows();
+		if (data_offset_ > 0)
+		{
+			close_with_header();
+		}
+		else
+		{
+			if (target_file_size_ > file_size_)
+			{
+				filling((target_file_size_ - file_size_) / type_size_);
+			}
+			if (file_size(path_) > target_file_size_)
+			{
+				file_.close();
+				resize_file(path_, target_file_size_);
+			}
+		}
+		//   : filling()   ,  
+		save_checksums();
+	}
+
+	void default_serialization(std::fstream file_, T elem)
+	{
+		file_.write(reinterpret_cast<char*>(&elem), type_size_);
+	}
+
+	void init_windows(const VectorFileOptions& options)
+	{
+		append_capacity_ = std::max<size_t>(1, options.append_buffer / type_size_);
+		if (options.direct)
+		{
+			//       ,    direct  
+			direct_ = FileHandle(path_, is_write_, true);
+			aligned_ = AlignedBuffer(FileHandle::direct_alignment);
+			direct_unit_ = FileHandle::direct_alignment / std::gcd(type_size_, FileHandle::direct_alignment);
+			window_allocator_ = AlignedAllocator<T>(FileHandle::direct_alignment);
+			prefetch_ = false;
+		}
+		if (prefetch_ && storage_ == StorageMode::stream && bulk_)
+		{
+			prefetcher_ = std::make_unique<WindowPrefetcher<T, S, mappable_>>(path_, options.io_engine);
+		}
+		if (options.write_behind > 0 && is_write_ && storage_ == StorageMode::stream && bulk_ && !options.direct)
+		{
+			writer_ = std::make_unique<WindowWriter<T, S, mappable_>>(path_, options.write_behind, options.io_engine);
+		}
+		if (options.io_engine != IoEngineKind::positional && storage_ == StorageMode::stream && bulk_ && !options.direct)
+		{
+			engine_ = make_io_engine(options.io_engine, path_, is_write_);
+		}
+		window_elems_ = fixed_window_ ? WindowElems : std::max<size_t>(1, target_window_size_ / type_size_);
+		if (!fixed_window_ && options.direct)
+		{
+			//   :      ,       
+			window_elems_ = (window_elems_ + direct_unit_ - 1) / direct_unit_ * direct_unit_;
+		}
+		init_checksums(options.checksums);
+		add_windows(std::max<size_t>(1, options.windows));
+		read(windows_[0], 0);
+		pages_.emplace(0, 0);
+		windows_[0].last_use = ++clock_;
+		cache_current();
+	}
+
+	size_t window_elems() const noexcept
+	{
+		if constexpr (fixed_window_)
+		{
+			return WindowElems;
+		}
+		else
+		{
+			return window_elems_;
+		}
+	}
+
+	size_t page_of(size_t index) const noexcept
+	{
+		if constexpr (fixed_window_)
+		{
+			return index >> window_shift_;
+		}
+		else
+		{
+			return index / window_elems_;
+		}
+	}
+
+	//   
+	size_t page_first(size_t page) const noexcept
+	{
+		if constexpr (fixed_window_)
+		{
+			return page << window_shift_;
+		}
+		else
+		{
+			return page * window_elems_;
+		}
+	}
+
+	T* data(Window& window) noexcept
+	{
+		return storage_ == StorageMode::mapped ? reinterpret_cast<T*>(window.view.data()) : window.buffer.data();
+	}
+
+	size_t size(const Window& window) const noexcept
+	{
+		return storage_ == StorageMode::mapped ? window.count : window.buffer.size();
+	}
+
+	//        ,  cache_current()
+	T& locate(size_t index, bool modify)
+	{
+		const size_t position = index - current_first_;
+		if (position < current_count_)
+		{
+			++hits_;
+			if (modify)
+			{
+				mark_dirty(windows_[current_], position);
+			}
+			return current_data_[position];
+		}
+		return locate_slow(index, modify);
+	}
+
+	//       ;    
+	T& locate_slow(size_t index, bool modify)
+	{
+		if (target_file_size_ / type_size_ <= index)
+		{
+			throw goind_out_of_file();
+		}
+		const size_t page = page_of(index);
+		const size_t position = index - page_first(page);
+		if (windows_[current_].page != page || position >= size(windows_[current_]))
+		{
+			if (!append_.empty() && index >= append_offset_ / type_size_)
+			{
+				return append_[index - append_offset_ / type_size_];
+			}
+			const auto found = pages_.find(page);
+			if (found != pages_.end() && position < size(windows_[found->second]))
+			{
+				current_ = found->second;
+				windows_[current_].last_use = ++clock_;
+				cache_current();
+			}
+			else
+			{
+				++misses_;
+				seek_window(index);
+				--hits_;
+			}
+		}
+		++hits_;
+		Window& window = windows_[current_];
+		if (modify)
+		{
+			mark_dirty(window, position);
+		}
+		return data(window)[position];
+	}
+
+	//  ,         .
+	//        posix_fadvise.
+	void prefetch(size_t page)
+	{
+		const size_t offset = page_first(page) * type_size_;
+		if (offset >= file_size_ || pages_.contains(page))
+		{
+			return;
+		}
+		const size_t number_elem = std::min(window_elems(), (file_size_ - offset) / type_size_);
+		if (writer_ && writer_->pending(data_offset_ + offset, number_elem * type_size_))
+		{
+			return;
+		}
+		if (prefetcher_)
+		{
+			prefetcher_->request(page, data_offset_ + offset, number_elem);
+		}
+		else if (!direct_.is_open())
+		{
+			handle_.advise(data_offset_ + offset, number_elem * type_size_);
+		}
+	}
+
+	//    
+	void flush_append()
+	{
+		if (append_.empty())
+		{
+			return;
+		}
+		if constexpr (bulk_)
+		{
+			write_tail(append_offset_, append_.data(), append_.size());
+		}
+		else
+		{
+			if (append_offset_ > file_size_)
+			{
+				filling((append_offset_ - file_size_) / type_size_);
+			}
+			file_.clear();
+			file_.seekp(data_offset_ + append_offset_, std::ios::beg);
+			for (T& elem : append_)
+			{
+				S::serialization(file_, elem);
+			}
+			file_.flush();
+			file_size_ = std::max(file_size_, append_offset_ + append_.size() * type_size_);
+		}
+		append_.clear();
+	}
+
+	//   offset,   file_size_.       .
+	void write_tail(size_t offset, const T* data, size_t count)
+	{
+		if (offset > file_size_)
+		{
+			filling((offset - file_size_) / type_size_);
+		}
+		if (storage_ == StorageMode::mapped)
+		{
+			if (offset + count * type_size_ > file_size_)
+			{
+				filling((offset + count * type_size_ - file_size_) / type_size_);
+			}
+			handle_.write_at(data_offset_ + offset, data, count * type_size_);
+		}
+		else
+		{
+			invalidate(offset / type_size_, offset / type_size_ + count);
+			write_block(offset, data, count);
+		}
+		file_size_ = std::max(file_size_, offset + count * type_size_);
+	}
+
+	//   ,      
+	//    
+	size_t victim() const
+	{
+		size_t slot = no_page_;
+		for (size_t i = 0; i < windows_.size(); i++)
+		{
+			if (windows_[i].page == no_page_)
+			{
+				return i;
+			}
+			if (windows_[i].pins == 0 && (slot == no_page_ || windows_[i].last_use < windows_[slot].last_use))
+			{
+				slot = i;
+			}
+		}
+		if (slot == no_page_)
+		{
+			throw window_pinned();
+		}
+		return slot;
+	}
+
+	//   first    ;        
+	std::pair<size_t, size_t> pin(size_t first, size_t count)
+	{
+		flush_append();
+		locate(first, false);
+		Window& window = windows_[current_];
+		const size_t position = first - page_first(window.page);
+		++window.pins;
+		return { current_, std::min(count, size(window) - position) };
+	}
+
+	void mark_dirty(Window& window, size_t position) noexcept
+	{
+		if (window.dirty_first >= window.dirty_last)
+		{
+			window.dirty_first = position;
+			window.dirty_last = position + 1;
+			return;
+		}
+		window.dirty_first = std::min(window.dirty_first, position);
+		window.dirty_last = std::max(window.dirty_last, position + 1);
+	}
+
+	void truncate(Window& window, size_t count)
+	{
+		if (storage_ == StorageMode::mapped)
+		{
+			window.count = count;
+		}
+		else
+		{
+			window.buffer.resize(count);
+		}
+		window.dirty_last = std::min(window.dirty_last, count);
+		cache_current();
+	}
+
+	void cache_current() noexcept
+	{
+		Window& window = windows_[current_];
+		current_first_ = window.page == no_page_ ? 0 : page_first(window.page);
+		current_count_ = window.page == no_page_ ? 0 : size(window);
+		current_data_ = data(window);
+	}
+
+	void read(Window& window, size_t page)
+	{
+		window.page = page;
+		window.offset = page_first(page) * type_size_;
+		window.buffer.clear();
+		window.dirty_first = 0;
+		window.dirty_last = 0;
+		const size_t number_elem = window.offset >= file_size_ ? 0 : std::min(window_elems(), (file_size_ - window.offset) / type_size_);
+		if (storage_ == StorageMode::mapped)
+		{
+			window.view = MappedView();
+			window.view = handle_.map(data_offset_ + window.offset, number_elem * type_size_);
+			window.count = number_elem;
+			return;
+		}
+
+		if constexpr (bulk_)
+		{
+			if (prefetcher_ && prefetcher_->take(page, number_elem, window.buffer))
+			{
+				++prefetch_hits_;
+			}
+			else
+			{
+				window.buffer.resize(number_elem);
+				read_block(window.offset, window.buffer.data(), number_elem);
+			}
+			verify(window);
+		}
+		else
+		{
+			file_.clear();
+			file_.seekg(data_offset_ + window.offset, std::ios::beg);
+			for (size_t i = 0; i < number_elem; i++)
+			{
+				T obj;
+				S::deserialization(file_, obj);
+				//file_.read(reinterpret_cast<char*>(&obj), type_size_);
+				window.buffer.push_back(obj);
+			}
+		}
+	}
+
+	//    ;       
+	void evict(Window& window)
+	{
+		if (!writer_ || window.dirty_first >= window.dirty_last)
+		{
+			write(window);
+			return;
+		}
+		record(window);
+		writer_->push(data_offset_ + window.offset, std::move(window.buffer), window.dirty_first, window.dirty_last);
+		window.buffer = writer_->recycle();
+		window.dirty_first = 0;
+		window.dirty_last = 0;
+	}
+
+	void write(Window& window)
+	{
+		if (storage_ == StorageMode::mapped || window.dirty_first >= window.dirty_last)
+		{
+			return;
+		}
+		if constexpr (bulk_)
+		{
+			if (direct_.is_open())
+			{
+				//      ,     
+				window.dirty_first = window.dirty_first / direct_unit_ * direct_unit_;
+				window.dirty_last = std::min(window.buffer.size(), (window.dirty_last + direct_unit_ - 1) / direct_unit_ * direct_unit_);
+			}
+			write_block(window.offset + window.dirty_first * type_size_, window.buffer.data() + window.dirty_first, window.dirty_last - window.dirty_first);
+			record(window);
+		}
+		else
+		{
+			file_.clear();
+			file_.seekp(data_offset_ + window.offset + window.dirty_first * type_size_, std::ios::beg);
+			for (size_t i = window.dirty_first; i < window.dirty_last; i++)
+			{
+				S::serialization(file_, window.buffer[i]);
+				//file_.write(reinterpret_cast<char*>(&buffer_[i]), type_size_);
+			}
+		}
+		window.dirty_first = 0;
+		window.dirty_last = 0;
+	}
+
+	//offset -   ;      data_offset_
+	void read_block(size_t offset, T* data, size_t count)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+		offset += data_offset_;
+		if (writer_)
+		{
+			writer_->wait_for(offset, count * type_size_);
+		}
+		if (direct_.is_open())
+		{
+			read_direct(offset, data, count);
+		}
+		else if constexpr (mappable_)
+		{
+			read_bytes(offset, data, count * type_size_);
+		}
+		else
+		{
+			bytes_.resize(count * type_size_);
+			read_bytes(offset, bytes_.data(), bytes_.size());
+			S::deserialization(std::span<const char>(bytes_), std::span<T>(data, count));
+		}
+	}
+
+	void write_block(size_t offset, const T* data, size_t count)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+		offset += data_offset_;
+		if (writer_)
+		{
+			writer_->wait_for(offset, count * type_size_);
+		}
+		if (direct_.is_open())
+		{
+			write_direct(offset, data, count);
+		}
+		else if constexpr (mappable_)
+		{
+			write_bytes(offset, data, count * type_size_);
+		}
+		else
+		{
+			bytes_.resize(count * type_size_);
+			S::serialization(std::span<const T>(data, count), std::span<char>(bytes_));
+			write_bytes(offset, bytes_.data(), bytes_.size());
+		}
+	}
+
+	//      io_chunk_,       
+	void read_bytes(size_t offset, void* data, size_t length)
+	{
+		if (!engine_)
+		{
+			handle_.read_at(offset, data, length);
+			return;
+		}
+		requests_.clear();
+		for (size_t done = 0; done < length; done += io_chunk_)
+		{
+			requests_.push_back({ false, offset + done, static_cast<char*>(data) + done, std::min(io_chunk_, length - done) });
+		}
+		engine_->submit(requests_);
+	}
+
+	void write_bytes(size_t offset, const void* data, size_t length)
+	{
+		if (!engine_)
+		{
+			handle_.write_at(offset, data, length);
+			return;
+		}
+		requests_.clear();
+		for (size_t done = 0; done < length; done += io_chunk_)
+		{
+			requests_.push_back({ true, offset + done, const_cast<char*>(static_cast<const char*>(data)) + done, std::min(io_chunk_, length - done) });
+		}
+		engine_->submit(requests_);
+	}
+
+	//    ;   -  
+	void write_windows()
+	{
+		if (!engine_)
+		{
+			for (Window& window : windows_)
+			{
+				write(window);
+			}
+			return;
+		}
+		if constexpr (bulk_)
+		{
+			requests_.clear();
+			size_t staged = 0;
+			for (Window& window : windows_)
+			{
+				if (window.dirty_first >= window.dirty_last)
+				{
+					continue;
+				}
+				const size_t count = window.dirty_last - window.dirty_first;
+				const size_t offset = data_offset_ + window.offset + window.dirty_first * type_size_;
+				if (writer_)
+				{
+					writer_->wait_for(offset, count * type_size_);
+				}
+				char* data;
+				if constexpr (mappable_)
+				{
+					data = reinterpret_cast<char*>(window.buffer.data() + window.dirty_first);
+				}
+				else
+				{
+					if (staging_.size() <= staged)
+					{
+						staging_.emplace_back();
+					}
+					std::vector<char>& bytes = staging_[staged++];
+					bytes.resize(count * type_size_);
+					S::serialization(std::span<const T>(window.buffer.data() + window.dirty_first, count), std::span<char>(bytes));
+					data = bytes.data();
+				}
+				requests_.push_back({ true, offset, data, count * type_size_ });
+				record(window);
+			}
+			engine_->submit(requests_);
+			for (Window& window : windows_)
+			{
+				window.dirty_first = 0;
+				window.dirty_last = 0;
+			}
+		}
+	}
+
+	//             
+	bool direct_aligned(size_t offset, const T* data, size_t count) const noexcept
+	{
+		const size_t block = FileHandle::direct_alignment;
+		return mappable_ && offset % block == 0 && count * type_size_ % block == 0 && reinterpret_cast<uintptr_t>(data) % block == 0;
+	}
+
+	// :          
+	void read_direct(size_t offset, T* data, size_t count)
+	{
+		if (direct_aligned(offset, data, count))
+		{
+			direct_.read_at(offset, data, count * type_size_);
+			return;
+		}
+		const size_t block = FileHandle::direct_alignment;
+		const size_t first = offset / block * block;
+		const size_t last = (offset + count * type_size_ + block - 1) / block * block;
+		aligned_.reserve(last - first);
+		if (direct_.read_some_at(first, aligned_.data(), last - first) < offset + count * type_size_ - first)
+		{
+			throw std::runtime_error("Could not read from file.");
+		}
+		S::deserialization(std::span<const char>(aligned_.data() + (offset - first), count * type_size_), std::span<T>(data, count));
+	}
+
+	// :      ,      
+	//   
+	void write_direct(size_t offset, const T* data, size_t count)
+	{
+		if (direct_aligned(offset, data, count))
+		{
+			direct_.write_at(offset, data, count * type_size_);
+			return;
+		}
+		const size_t block = FileHandle::direct_alignment;
+		const size_t end = offset + count * type_size_;
+		const size_t first = offset / block * block;
+		const size_t last = (end + block - 1) / block * block;
+		const size_t disk_size = direct_.size();
+		aligned_.reserve(last - first);
+		if (first < offset)
+		{
+			read_edge(first, aligned_.data());
+		}
+		if (end < last && (last - block > first || first == offset))
+		{
+			read_edge(last - block, aligned_.data() + (last - block - first));
+		}
+		S::serialization(std::span<const T>(data, count), std::span<char>(aligned_.data() + (offset - first), count * type_size_));
+		direct_.write_at(first, aligned_.data(), last - first);
+		if (last > std::max(disk_size, end))
+		{
+			direct_.resize(std::max(disk_size, end));
+		}
+	}
+
+	void read_edge(size_t offset, char* block)
+	{
+		const size_t done = direct_.read_some_at(offset, block, FileHandle::direct_alignment);
+		std::memset(block + done, 0, FileHandle::direct_alignment - done);
+	}
+
+	std::filesystem::path checksum_file() const
+	{
+		std::filesystem::path path = path_;
+		path += ".crc";
+		return path;
+	}
+
+	//       . ,      ,
+	//  ,    .
+	void init_checksums(bool enabled)
+	{
+		if (!enabled)
+		{
+			if (is_write_)
+			{
+				std::filesystem::remove(checksum_file());
+			}
+			return;
+		}
+		checksum_path_ = checksum_file();
+		std::ifstream table(checksum_path_, std::ios::binary);
+		uint64_t header[2] = {};
+		if (!table.read(reinterpret_cast<char*>(header), sizeof(header)) || header[0] != window_elems() || header[1] != type_size_)
+		{
+			return;
+		}
+		checksums_.resize((std::filesystem::file_size(checksum_path_) - sizeof(header)) / sizeof(PageChecksum));
+		if (!table.read(reinterpret_cast<char*>(checksums_.data()), checksums_.size() * sizeof(PageChecksum)))
+		{
+			checksums_.clear();
+		}
+	}
+
+	void save_checksums()
+	{
+		if (!checksums_dirty_)
+		{
+			return;
+		}
+		std::ofstream table(checksum_path_, std::ios::binary | std::ios::trunc);
+		const uint64_t header[2] = { window_elems(), type_size_ };
+		table.write(reinterpret_cast<const char*>(header), sizeof(header));
+		table.write(reinterpret_cast<const char*>(checksums_.data()), checksums_.size() * sizeof(PageChecksum));
+		if (!table)
+		{
+			throw std::runtime_error("Could not write checksum table.");
+		}
+		checksums_dirty_ = false;
+	}
+
+	//CRC32C     ,      
+	uint32_t page_crc(const Window& window)
+	{
+		const size_t count = window.buffer.size();
+		if constexpr (mappable_)
+		{
+			return crc32c(window.buffer.data(), count * type_size_);
+		}
+		else if constexpr (bulk_)
+		{
+			bytes_.resize(count * type_size_);
+			S::serialization(std::span<const T>(window.buffer.data(), count), std::span<char>(bytes_));
+			return crc32c(bytes_.data(), bytes_.size());
+		}
+		else
+		{
+			return 0;
+		}
+	}
 
-		file_.clear();
-		file_.seekg(offset_window_, std::ios::beg);
-		for (size_t i = 0; i < number_elem; i++)
+	//  .       (   )   .
+	void verify(Window& window)
+	{
+		if (checksum_path_.empty() || window.buffer.empty())
 		{
-			T obj;
-			S::deserialization(file_, obj);
-			//file_.read(reinterpret_cast<char*>(&obj), type_size_);
-			buffer_.push_back(obj);
+			return;
+		}
+		const uint32_t crc = page_crc(window);
+		if (window.page < checksums_.size() && checksums_[window.page].count == window.buffer.size())
+		{
+			if (checksums_[window.page].crc != crc)
+			{
+				pages_.erase(window.page);
+				window.page = no_page_;
+				window.buffer.clear();
+				cache_current();
+				throw checksum_error();
+			}
+			return;
 		}
+		set_checksum(window.page, { crc, static_cast<uint32_t>(window.buffer.size()) });
+	}
 
+	//     
+	void record(const Window& window)
+	{
+		if (!checksum_path_.empty() && !window.buffer.empty())
+		{
+			set_checksum(window.page, { page_crc(window), static_cast<uint32_t>(window.buffer.size()) });
+		}
+	}
 
+	void set_checksum(size_t page, PageChecksum entry)
+	{
+		if (page >= checksums_.size())
+		{
+			checksums_.resize(page + 1, PageChecksum{ 0, 0 });
+		}
+		checksums_[page] = entry;
+		checksums_dirty_ = true;
 	}
 
-	void write()
+	//  ,  [first, last)     
+	void invalidate(size_t first, size_t last)
 	{
-		file_.clear();
-		file_.seekp(offset_window_, std::ios::beg);
-		for (size_t i = 0; i < buffer_.size(); i++)
+		if (checksum_path_.empty() || first >= last)
+		{
+			return;
+		}
+		for (size_t page = page_of(first); page <= page_of(last - 1) && page < checksums_.size(); page++)
 		{
-			S::serialization(file_, buffer_[i]);
-			//file_.write(reinterpret_cast<char*>(&buffer_[i]), type_size_);
+			checksums_[page].count = 0;
+			checksums_dirty_ = true;
 		}
 	}
 
@@ -329,16 +1763,100 @@ private:
 		return file_size;
 	}
 
+	//,   file_size_,    : Windows      .
+	//    .
+	void unmap_tail()
+	{
+		if (storage_ != StorageMode::mapped)
+		{
+			return;
+		}
+		for (Window& window : windows_)
+		{
+			if (window.page == no_page_ || window.offset + window.view.size() <= file_size_)
+			{
+				continue;
+			}
+			if (window.pins > 0)
+			{
+				throw window_pinned();
+			}
+			pages_.erase(window.page);
+			window.page = no_page_;
+			window.view = MappedView();
+			window.count = 0;
+		}
+		cache_current();
+	}
+
+	//    file_size_.   file_size_   pop_back/resize  .
 	void filling(const size_t number_elem)
 	{
-		file_.clear();
-		file_.seekp(0, std::ios::end);
+		const size_t new_file_size = file_size_ + number_elem * type_size_;
+		invalidate(file_size_ / type_size_, new_file_size / type_size_);
+		file_.flush();
+		if (handle_.size() > data_offset_ + file_size_)
+		{
+			if (writer_)
+			{
+				writer_->drain();
+			}
+			unmap_tail();
+			handle_.resize(data_offset_ + file_size_);
+		}
+
+		switch (growth_)
+		{
+		case GrowthPolicy::sparse:
+			handle_.resize(data_offset_ + new_file_size);
+			break;
+		case GrowthPolicy::allocate:
+			handle_.allocate(data_offset_ + file_size_, new_file_size - file_size_);
+			break;
+		case GrowthPolicy::zero_fill:
+		{
+			const std::vector<char> zeros(std::min(new_file_size - file_size_, zero_chunk_size_));
+			for (size_t offset = file_size_; offset < new_file_size; offset += zeros.size())
+			{
+				handle_.write_at(data_offset_ + offset, zeros.data(), std::min(zeros.size(), new_file_size - offset));
+			}
+			break;
+		}
+		}
+		file_size_ = new_file_size;
+	}
+
+	//   ,   :         
+	bool read_header()
+	{
+		VectorFileHeader header;
+		if (!VectorFileHeader::read<T, S>(handle_, header))
+		{
+			return false;
+		}
+		data_offset_ = VectorFileHeader::size;
+		target_file_size_ = header.count * type_size_;
+		if (target_window_size_ == 0)
+		{
+			target_window_size_ = header.window_size;
+		}
+		return true;
+	}
+
+	void write_header()
+	{
+		VectorFileHeader::write<T, S>(handle_, target_file_size_ / type_size_, fixed_window_ ? WindowElems * type_size_ : target_window_size_);
+	}
 
-		for (size_t i = 0; i < number_elem * type_size_; i++)
+	//       :  pop_back/resize     
+	//.    filling(),     ,      .
+	void close_with_header()
+	{
+		if (target_file_size_ > file_size_)
 		{
-			file_.write("\0", 1);
+			filling((target_file_size_ - file_size_) / type_size_);
 		}
-		file_size_ += number_elem * type_size_;
+		write_header();
 	}
 
 	size_t align_filesize_to_typesize(size_t original_file_size) const
@@ -0,0 +1,143 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <nmmintrin.h>
+#define VECTOR_FILE_CRC32C_X86
+#elif defined(_M_X64)
+#include <nmmintrin.h>
+#include <intrin.h>
+#define VECTOR_FILE_CRC32C_X86
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define VECTOR_FILE_CRC32C_ARM
+#endif
+
+
+//CRC32C ( ). crc -    ,       .
+namespace crc32c_detail
+{
+	constexpr uint32_t polynomial = 0x82F63B78;	//  
+
+	//    8  (slicing-by-8)
+	constexpr std::array<std::array<uint32_t, 256>, 8> make_tables()
+	{
+		std::array<std::array<uint32_t, 256>, 8> tables{};
+		for (uint32_t i = 0; i < 256; i++)
+		{
+			uint32_t crc = i;
+			for (int bit = 0; bit < 8; bit++)
+			{
+				crc = crc & 1 ? (crc >> 1) ^ polynomial : crc >> 1;
+			}
+			tables[0][i] = crc;
+		}
+		for (uint32_t i = 0; i < 256; i++)
+		{
+			for (size_t k = 1; k < 8; k++)
+			{
+				tables[k][i] = (tables[k - 1][i] >> 8) ^ tables[0][tables[k - 1][i] & 0xFF];
+			}
+		}
+		return tables;
+	}
+
+	inline constexpr auto tables = make_tables();
+
+	inline uint32_t table(const unsigned char* data, size_t length, uint32_t crc) noexcept
+	{
+		for (; length >= 8; data += 8, length -= 8)
+		{
+			uint32_t low;
+			uint32_t high;
+			std::memcpy(&low, data, 4);
+			std::memcpy(&high, data + 4, 4);
+			low ^= crc;
+			crc = tables[7][low & 0xFF] ^ tables[6][(low >> 8) & 0xFF] ^ tables[5][(low >> 16) & 0xFF] ^ tables[4][low >> 24]
+				^ tables[3][high & 0xFF] ^ tables[2][(high >> 8) & 0xFF] ^ tables[1][(high >> 16) & 0xFF] ^ tables[0][high >> 24];
+		}
+		for (; length > 0; ++data, --length)
+		{
+			crc = (crc >> 8) ^ tables[0][(crc ^ *data) & 0xFF];
+		}
+		return crc;
+	}
+
+#ifdef VECTOR_FILE_CRC32C_X86
+#if defined(__GNUC__) || defined(__clang__)
+	__attribute__((target("sse4.2")))
+#endif
+	inline uint32_t hardware(const unsigned char* data, size_t length, uint32_t crc) noexcept
+	{
+		uint64_t value = crc;
+		for (; length >= 8; data += 8, length -= 8)
+		{
+			uint64_t word;
+			std::memcpy(&word, data, 8);
+			value = _mm_crc32_u64(value, word);
+		}
+		crc = static_cast<uint32_t>(value);
+		for (; length > 0; ++data, --length)
+		{
+			crc = _mm_crc32_u8(crc, *data);
+		}
+		return crc;
+	}
+
+	//SSE4.2    :   -msse4.2    CRC
+	inline bool has_hardware() noexcept
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		static const bool supported = __builtin_cpu_supports("sse4.2");
+#else
+		static const bool supported = []
+		{
+			int info[4];
+			__cpuid(info, 1);
+			return (info[2] & (1 << 20)) != 0;
+		}();
+#endif
+		return supported;
+	}
+#elif defined(VECTOR_FILE_CRC32C_ARM)
+	inline uint32_t hardware(const unsigned char* data, size_t length, uint32_t crc) noexcept
+	{
+		for (; length >= 8; data += 8, length -= 8)
+		{
+			uint64_t word;
+			std::memcpy(&word, data, 8);
+			crc = __crc32cd(crc, word);
+		}
+		for (; length > 0; ++data, --length)
+		{
+			crc = __crc32cb(crc, *data);
+		}
+		return crc;
+	}
+
+	inline bool has_hardware() noexcept
+	{
+		return true;
+	}
+#endif
+}
+
+//  -        CRC32C
+inline uint32_t crc32c_portable(const void* data, size_t length, uint32_t crc = 0) noexcept
+{
+	return ~crc32c_detail::table(static_cast<const unsigned char*>(data), length, ~crc);
+}
+
+inline uint32_t crc32c(const void* data, size_t length, uint32_t crc = 0) noexcept
+{
+#if defined(VECTOR_FILE_CRC32C_X86) || defined(VECTOR_FILE_CRC32C_ARM)
+	if (crc32c_detail::has_hardware())
+	{
+		return ~crc32c_detail::hardware(static_cast<const unsigned char*>(data), length, ~crc);
+	}
+#endif
+	return crc32c_portable(data, length, crc);
+}
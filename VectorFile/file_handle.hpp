@@ -0,0 +1,553 @@
+#pragma once
+#include <filesystem>
+#include <stdexcept>
+#include <utility>
+#include <new>
+#include <vector>
+#include <type_traits>
+#include <algorithm>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <cerrno>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+class MappedView final
+{
+	void* base_ = nullptr;	//  (  )
+	size_t length_ = 0;		//  ()
+	size_t shift_ = 0;		//     ()
+
+public:
+	MappedView() = default;
+	MappedView(void* base, size_t length, size_t shift) : base_(base), length_(length), shift_(shift) { }
+
+	~MappedView()
+	{
+		unmap();
+	}
+
+	MappedView(MappedView&& other) noexcept
+	{
+		swap(other);
+	}
+
+	MappedView& operator=(MappedView&& other) noexcept
+	{
+		MappedView temp(std::move(other));
+		swap(temp);
+		return *this;
+	}
+
+	MappedView(const MappedView&) = delete;
+	MappedView& operator=(const MappedView&) = delete;
+
+	char* data() const noexcept
+	{
+		return static_cast<char*>(base_) + shift_;
+	}
+
+	size_t size() const noexcept
+	{
+		return length_ - shift_;
+	}
+
+	bool empty() const noexcept
+	{
+		return base_ == nullptr;
+	}
+
+	void sync() const
+	{
+		if (empty())
+		{
+			return;
+		}
+#ifdef _WIN32
+		FlushViewOfFile(base_, length_);
+#else
+		msync(base_, length_, MS_ASYNC);
+#endif
+	}
+
+	void unmap() noexcept
+	{
+		if (empty())
+		{
+			return;
+		}
+#ifdef _WIN32
+		UnmapViewOfFile(base_);
+#else
+		munmap(base_, length_);
+#endif
+		base_ = nullptr;
+		length_ = 0;
+		shift_ = 0;
+	}
+
+	void swap(MappedView& other) noexcept
+	{
+		std::swap(base_, other.base_);
+		std::swap(length_, other.length_);
+		std::swap(shift_, other.shift_);
+	}
+};
+
+
+//,       -
+class AlignedBuffer final
+{
+	char* data_ = nullptr;	// 
+	size_t size_ = 0;		//  ()
+	size_t alignment_ = 1;	// ()
+
+public:
+	AlignedBuffer() = default;
+	explicit AlignedBuffer(size_t alignment) : alignment_(alignment) { }
+
+	~AlignedBuffer()
+	{
+		release();
+	}
+
+	AlignedBuffer(AlignedBuffer&& other) noexcept
+	{
+		swap(other);
+	}
+
+	AlignedBuffer& operator=(AlignedBuffer&& other) noexcept
+	{
+		AlignedBuffer temp(std::move(other));
+		swap(temp);
+		return *this;
+	}
+
+	AlignedBuffer(const AlignedBuffer&) = delete;
+	AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+	char* data() const noexcept
+	{
+		return data_;
+	}
+
+	//   size ;    
+	void reserve(size_t size)
+	{
+		if (size <= size_)
+		{
+			return;
+		}
+		release();
+		data_ = static_cast<char*>(::operator new(size, std::align_val_t(alignment_)));
+		size_ = size;
+	}
+
+	void swap(AlignedBuffer& other) noexcept
+	{
+		std::swap(data_, other.data_);
+		std::swap(size_, other.size_);
+		std::swap(alignment_, other.alignment_);
+	}
+
+private:
+	void release() noexcept
+	{
+		if (data_ != nullptr)
+		{
+			::operator delete(data_, std::align_val_t(alignment_));
+			data_ = nullptr;
+			size_ = 0;
+		}
+	}
+};
+
+
+//  ,   ;   -   T.
+//    direct          .
+template <class T>
+class AlignedAllocator
+{
+	template <class U>
+	friend class AlignedAllocator;
+
+	size_t alignment_ = alignof(T);	// ()
+
+public:
+	using value_type = T;
+	using propagate_on_container_copy_assignment = std::true_type;
+	using propagate_on_container_move_assignment = std::true_type;
+	using propagate_on_container_swap = std::true_type;
+
+	AlignedAllocator() = default;
+	explicit AlignedAllocator(size_t alignment) noexcept : alignment_(std::max(alignment, alignof(T))) { }
+
+	template <class U>
+	AlignedAllocator(const AlignedAllocator<U>& other) noexcept : alignment_(std::max(other.alignment_, alignof(T))) { }
+
+	T* allocate(size_t count)
+	{
+		if (alignment_ <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+		{
+			return static_cast<T*>(::operator new(count * sizeof(T)));
+		}
+		return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(alignment_)));
+	}
+
+	void deallocate(T* data, size_t) noexcept
+	{
+		if (alignment_ <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+		{
+			::operator delete(data);
+			return;
+		}
+		::operator delete(data, std::align_val_t(alignment_));
+	}
+
+	bool operator==(const AlignedAllocator& other) const noexcept
+	{
+		return alignment_ == other.alignment_;
+	}
+};
+
+//  
+template <class T>
+using WindowBuffer = std::vector<T, AlignedAllocator<T>>;
+
+
+class FileHandle final
+{
+#ifdef _WIN32
+	HANDLE handle_ = INVALID_HANDLE_VALUE;	// 
+#else
+	int fd_ = -1;							// 
+#endif
+	bool is_write_ = false;					// -/
+	bool direct_ = false;					// -    
+
+public:
+	static constexpr size_t direct_alignment = 4096;	// ,     - ()
+
+	FileHandle() = default;
+
+	//direct -    - (O_DIRECT, FILE_FLAG_NO_BUFFERING).    
+	// ,    ;       .
+	FileHandle(const std::filesystem::path& path, bool is_write, bool direct = false) : is_write_(is_write), direct_(direct)
+	{
+#ifdef _WIN32
+		const DWORD access = is_write_ ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ;
+		const DWORD flags = direct_ ? FILE_ATTRIBUTE_NORMAL | FILE_FLAG_NO_BUFFERING | FILE_FLAG_WRITE_THROUGH : FILE_ATTRIBUTE_NORMAL;
+		handle_ = CreateFileW(path.c_str(), access, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, flags, nullptr);
+#else
+		int flags = is_write_ ? O_RDWR : O_RDONLY;
+#ifdef O_DIRECT
+		if (direct_)
+		{
+			fd_ = ::open(path.c_str(), flags | O_DIRECT);
+			if (fd_ == -1 && errno == EINVAL)
+			{
+				direct_ = false;
+			}
+		}
+#else
+		direct_ = false;
+#endif
+		if (!direct_)
+		{
+			fd_ = ::open(path.c_str(), flags);
+		}
+#endif
+		if (!is_open())
+		{
+			throw std::runtime_error("File does not exist or could not be opened for reading.");
+		}
+	}
+
+	~FileHandle()
+	{
+		close();
+	}
+
+	FileHandle(FileHandle&& other) noexcept
+	{
+		swap(other);
+	}
+
+	FileHandle& operator=(FileHandle&& other) noexcept
+	{
+		FileHandle temp(std::move(other));
+		swap(temp);
+		return *this;
+	}
+
+	FileHandle(const FileHandle&) = delete;
+	FileHandle& operator=(const FileHandle&) = delete;
+
+	bool is_open() const noexcept
+	{
+#ifdef _WIN32
+		return handle_ != INVALID_HANDLE_VALUE;
+#else
+		return fd_ != -1;
+#endif
+	}
+
+	bool direct() const noexcept
+	{
+		return direct_;
+	}
+
+	//  -   -,    
+#ifdef _WIN32
+	HANDLE native() const noexcept
+	{
+		return handle_;
+	}
+#else
+	int native() const noexcept
+	{
+		return fd_;
+	}
+#endif
+
+	size_t size() const
+	{
+#ifdef _WIN32
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(handle_, &size))
+		{
+			throw std::runtime_error("Could not get file size.");
+		}
+		return static_cast<size_t>(size.QuadPart);
+#else
+		struct stat info;
+		if (fstat(fd_, &info) != 0)
+		{
+			throw std::runtime_error("Could not get file size.");
+		}
+		return static_cast<size_t>(info.st_size);
+#endif
+	}
+
+	void resize(size_t new_size)
+	{
+#ifdef _WIN32
+		FILE_END_OF_FILE_INFO info;
+		info.EndOfFile.QuadPart = static_cast<LONGLONG>(new_size);
+		const bool done = SetFileInformationByHandle(handle_, FileEndOfFileInfo, &info, sizeof(info));
+#else
+		const bool done = ftruncate(fd_, static_cast<off_t>(new_size)) == 0;
+#endif
+		if (!done)
+		{
+			throw std::runtime_error("Could not resize file.");
+		}
+	}
+
+	//   [offset, offset + length)   ,  
+	void allocate(size_t offset, size_t length)
+	{
+		if (length == 0)
+		{
+			return;
+		}
+#ifdef _WIN32
+		FILE_ALLOCATION_INFO info;
+		info.AllocationSize.QuadPart = static_cast<LONGLONG>(offset + length);
+		if (!SetFileInformationByHandle(handle_, FileAllocationInfo, &info, sizeof(info)))
+		{
+			throw std::runtime_error("Could not allocate file space.");
+		}
+		if (size() < offset + length)
+		{
+			resize(offset + length);
+		}
+#else
+		if (posix_fallocate(fd_, static_cast<off_t>(offset), static_cast<off_t>(length)) != 0)
+		{
+			throw std::runtime_error("Could not allocate file space.");
+		}
+#endif
+	}
+
+	// :   
+	void advise(size_t offset, size_t length) const noexcept
+	{
+#ifndef _WIN32
+		posix_fadvise(fd_, static_cast<off_t>(offset), static_cast<off_t>(length), POSIX_FADV_WILLNEED);
+#endif
+	}
+
+	void read_at(size_t offset, void* data, size_t count) const
+	{
+		char* ptr = static_cast<char*>(data);
+		while (count > 0)
+		{
+#ifdef _WIN32
+			OVERLAPPED position{};
+			position.Offset = static_cast<DWORD>(offset);
+			position.OffsetHigh = static_cast<DWORD>(static_cast<unsigned long long>(offset) >> 32);
+			DWORD done = 0;
+			const DWORD portion = count > MAXDWORD ? MAXDWORD : static_cast<DWORD>(count);
+			if (!ReadFile(handle_, ptr, portion, &done, &position) || done == 0)
+			{
+				throw std::runtime_error("Could not read from file.");
+			}
+#else
+			const ssize_t done = pread(fd_, ptr, count, static_cast<off_t>(offset));
+			if (done <= 0)
+			{
+				throw std::runtime_error("Could not read from file.");
+			}
+#endif
+			ptr += done;
+			offset += done;
+			count -= done;
+		}
+	}
+
+	//  count ;       
+	size_t read_some_at(size_t offset, void* data, size_t count) const
+	{
+		char* ptr = static_cast<char*>(data);
+		size_t total = 0;
+		while (total < count)
+		{
+#ifdef _WIN32
+			OVERLAPPED position{};
+			position.Offset = static_cast<DWORD>(offset + total);
+			position.OffsetHigh = static_cast<DWORD>(static_cast<unsigned long long>(offset + total) >> 32);
+			DWORD done = 0;
+			const DWORD portion = count - total > MAXDWORD ? MAXDWORD : static_cast<DWORD>(count - total);
+			if (!ReadFile(handle_, ptr + total, portion, &done, &position))
+			{
+				if (GetLastError() == ERROR_HANDLE_EOF)
+				{
+					break;
+				}
+				throw std::runtime_error("Could not read from file.");
+			}
+#else
+			const ssize_t done = pread(fd_, ptr + total, count - total, static_cast<off_t>(offset + total));
+			if (done < 0)
+			{
+				throw std::runtime_error("Could not read from file.");
+			}
+#endif
+			if (done == 0)
+			{
+				break;
+			}
+			total += done;
+		}
+		return total;
+	}
+
+	void write_at(size_t offset, const void* data, size_t count)
+	{
+		const char* ptr = static_cast<const char*>(data);
+		while (count > 0)
+		{
+#ifdef _WIN32
+			OVERLAPPED position{};
+			position.Offset = static_cast<DWORD>(offset);
+			position.OffsetHigh = static_cast<DWORD>(static_cast<unsigned long long>(offset) >> 32);
+			DWORD done = 0;
+			const DWORD portion = count > MAXDWORD ? MAXDWORD : static_cast<DWORD>(count);
+			if (!WriteFile(handle_, ptr, portion, &done, &position) || done == 0)
+			{
+				throw std::runtime_error("Could not write to file.");
+			}
+#else
+			const ssize_t done = pwrite(fd_, ptr, count, static_cast<off_t>(offset));
+			if (done <= 0)
+			{
+				throw std::runtime_error("Could not write to file.");
+			}
+#endif
+			ptr += done;
+			offset += done;
+			count -= done;
+		}
+	}
+
+	//  [offset, offset + length).         ,
+	//   ,     ,    .
+	MappedView map(size_t offset, size_t length) const
+	{
+		if (length == 0)
+		{
+			return {};
+		}
+		const size_t aligned_offset = offset / granularity() * granularity();
+		const size_t shift = offset - aligned_offset;
+#ifdef _WIN32
+		HANDLE mapping = CreateFileMappingW(handle_, nullptr, is_write_ ? PAGE_READWRITE : PAGE_WRITECOPY, 0, 0, nullptr);
+		if (mapping == nullptr)
+		{
+			throw std::runtime_error("Could not map file.");
+		}
+		void* base = MapViewOfFile(mapping, is_write_ ? FILE_MAP_WRITE : FILE_MAP_COPY,
+			static_cast<DWORD>(static_cast<unsigned long long>(aligned_offset) >> 32), static_cast<DWORD>(aligned_offset), length + shift);
+		CloseHandle(mapping);
+		if (base == nullptr)
+		{
+			throw std::runtime_error("Could not map file.");
+		}
+#else
+		void* base = mmap(nullptr, length + shift, PROT_READ | PROT_WRITE, is_write_ ? MAP_SHARED : MAP_PRIVATE, fd_, static_cast<off_t>(aligned_offset));
+		if (base == MAP_FAILED)
+		{
+			throw std::runtime_error("Could not map file.");
+		}
+#endif
+		return MappedView(base, length + shift, shift);
+	}
+
+	static size_t granularity()
+	{
+#ifdef _WIN32
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		return info.dwAllocationGranularity;
+#else
+		static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+		return page_size;
+#endif
+	}
+
+	void close() noexcept
+	{
+		if (!is_open())
+		{
+			return;
+		}
+#ifdef _WIN32
+		CloseHandle(handle_);
+		handle_ = INVALID_HANDLE_VALUE;
+#else
+		::close(fd_);
+		fd_ = -1;
+#endif
+	}
+
+	void swap(FileHandle& other) noexcept
+	{
+#ifdef _WIN32
+		std::swap(handle_, other.handle_);
+#else
+		std::swap(fd_, other.fd_);
+#endif
+		std::swap(is_write_, other.is_write_);
+		std::swap(direct_, other.direct_);
+	}
+};
@@ -0,0 +1,302 @@
+#pragma once
+#include <vector>
+#include <span>
+#include <deque>
+#include <memory>
+#include <atomic>
+#include <stdexcept>
+#include <algorithm>
+#include <thread>
+#include <filesystem>
+#include "file_handle.hpp"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <cerrno>
+#define VECTOR_FILE_IO_URING
+#endif
+
+
+enum class IoEngineKind
+{
+	positional,	//pread/pwrite   
+	uring		//   io_uring (Linux),  positional
+};
+
+//  -
+struct IoRequest
+{
+	bool write;			//  
+	size_t offset;		//    ()
+	void* data;			//
+	size_t length;		// ()
+};
+
+//   -   .    .
+class IoEngine
+{
+public:
+	virtual ~IoEngine() = default;
+
+	//  ; ,   .     .
+	virtual void submit(std::span<const IoRequest> requests) = 0;
+};
+
+
+class PositionalEngine final : public IoEngine
+{
+	FileHandle handle_;		// 
+
+public:
+	PositionalEngine(const std::filesystem::path& path, bool is_write) : handle_(path, is_write) { }
+
+	void submit(std::span<const IoRequest> requests) override
+	{
+		for (const IoRequest& request : requests)
+		{
+			if (request.write)
+			{
+				handle_.write_at(request.offset, request.data, request.length);
+			}
+			else
+			{
+				handle_.read_at(request.offset, request.data, request.length);
+			}
+		}
+	}
+};
+
+
+#ifdef VECTOR_FILE_IO_URING
+// -  io_uring  liburing:   ,     entries,
+//    ,       .
+//    submit ():     ,   .
+//  submit        .
+class UringEngine final : public IoEngine
+{
+	static constexpr size_t max_length_ = 1 << 30;	//    ()
+
+	FileHandle handle_;					// 
+	int ring_ = -1;						// io_uring
+	unsigned entries_ = 0;				// 
+	void* sq_ring_ = MAP_FAILED;		// 
+	size_t sq_ring_size_ = 0;
+	void* cq_ring_ = MAP_FAILED;		// 
+	size_t cq_ring_size_ = 0;
+	io_uring_sqe* sqes_ = nullptr;		//  
+	size_t sqes_size_ = 0;
+	unsigned* sq_tail_ = nullptr;
+	unsigned* sq_mask_ = nullptr;
+	unsigned* sq_array_ = nullptr;
+	unsigned* cq_head_ = nullptr;
+	unsigned* cq_tail_ = nullptr;
+	unsigned* cq_mask_ = nullptr;
+	io_uring_cqe* cqes_ = nullptr;
+
+public:
+	UringEngine(const std::filesystem::path& path, bool is_write, unsigned entries) : handle_(path, is_write)
+	{
+		io_uring_params params{};
+		ring_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+		if (ring_ < 0)
+		{
+			throw std::runtime_error("Could not set up io_uring.");
+		}
+		entries_ = params.sq_entries;
+		sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+		cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+		if (params.features & IORING_FEAT_SINGLE_MMAP)
+		{
+			sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+		}
+		sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_, IORING_OFF_SQ_RING);
+		if (sq_ring_ == MAP_FAILED)
+		{
+			release();
+			throw std::runtime_error("Could not map io_uring.");
+		}
+		if (params.features & IORING_FEAT_SINGLE_MMAP)
+		{
+			cq_ring_ = sq_ring_;
+		}
+		else
+		{
+			cq_ring_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_, IORING_OFF_CQ_RING);
+		}
+		sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+		void* sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_, IORING_OFF_SQES);
+		if (cq_ring_ == MAP_FAILED || sqes == MAP_FAILED)
+		{
+			release();
+			throw std::runtime_error("Could not map io_uring.");
+		}
+		sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+		char* sq = static_cast<char*>(sq_ring_);
+		char* cq = static_cast<char*>(cq_ring_);
+		sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+		sq_mask_ = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+		sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+		cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+		cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+		cq_mask_ = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+		cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+	}
+
+	~UringEngine()
+	{
+		release();
+	}
+
+	UringEngine(const UringEngine&) = delete;
+	UringEngine& operator=(const UringEngine&) = delete;
+
+	void submit(std::span<const IoRequest> requests) override
+	{
+		std::vector<size_t> done(requests.size());	//    
+		std::deque<size_t> ready;					//,  
+		for (size_t i = 0; i < requests.size(); i++)
+		{
+			if (requests[i].length > 0)
+			{
+				ready.push_back(i);
+			}
+		}
+		unsigned in_flight = 0;
+		unsigned unsubmitted = 0;
+		bool failed = false;
+		while (!ready.empty() || in_flight > 0)
+		{
+			while (!ready.empty() && in_flight < entries_ && !failed)
+			{
+				const size_t index = ready.front();
+				ready.pop_front();
+				push(requests[index], done[index], index);
+				++in_flight;
+				++unsubmitted;
+			}
+			if (failed)
+			{
+				ready.clear();
+			}
+			const int submitted = enter(unsubmitted, in_flight > 0 ? 1 : 0);
+			if (submitted >= 0)
+			{
+				unsubmitted -= submitted;
+			}
+			else if (submitted != -EAGAIN && submitted != -EBUSY)
+			{
+				//    .     ,
+				//    submit   .
+				failed = true;
+				std::atomic_ref<unsigned>(*sq_tail_).store(*sq_tail_ - unsubmitted, std::memory_order_release);
+				in_flight -= unsubmitted;
+				unsubmitted = 0;
+			}
+			else if (in_flight == unsubmitted)
+			{
+				//   ,       -   
+				std::this_thread::yield();
+			}
+
+			unsigned head = *cq_head_;
+			const unsigned tail = std::atomic_ref<unsigned>(*cq_tail_).load(std::memory_order_acquire);
+			for (; head != tail; ++head)
+			{
+				const io_uring_cqe& cqe = cqes_[head & *cq_mask_];
+				const size_t index = static_cast<size_t>(cqe.user_data);
+				--in_flight;
+				if (cqe.res <= 0)
+				{
+					failed = true;
+					continue;
+				}
+				done[index] += cqe.res;
+				if (done[index] < requests[index].length && !failed)
+				{
+					ready.push_back(index);
+				}
+			}
+			std::atomic_ref<unsigned>(*cq_head_).store(head, std::memory_order_release);
+		}
+		if (failed)
+		{
+			throw std::runtime_error("Could not read from or write to file.");
+		}
+	}
+
+private:
+	void push(const IoRequest& request, size_t done, size_t index)
+	{
+		const unsigned tail = *sq_tail_;
+		const unsigned slot = tail & *sq_mask_;
+		io_uring_sqe& sqe = sqes_[slot];
+		sqe = io_uring_sqe{};
+		sqe.opcode = request.write ? IORING_OP_WRITE : IORING_OP_READ;
+		sqe.fd = handle_.native();
+		sqe.addr = reinterpret_cast<unsigned long long>(static_cast<char*>(request.data) + done);
+		sqe.len = static_cast<unsigned>(std::min(request.length - done, max_length_));
+		sqe.off = request.offset + done;
+		sqe.user_data = index;
+		sq_array_[slot] = slot;
+		std::atomic_ref<unsigned>(*sq_tail_).store(tail + 1, std::memory_order_release);
+	}
+
+	//     -errno
+	int enter(unsigned to_submit, unsigned min_complete) noexcept
+	{
+		while (true)
+		{
+			const long result = syscall(__NR_io_uring_enter, ring_, to_submit, min_complete, min_complete > 0 ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+			if (result >= 0)
+			{
+				return static_cast<int>(result);
+			}
+			if (errno != EINTR)
+			{
+				return -errno;
+			}
+		}
+	}
+
+	void release() noexcept
+	{
+		if (sqes_ != nullptr)
+		{
+			munmap(sqes_, sqes_size_);
+		}
+		if (cq_ring_ != MAP_FAILED && cq_ring_ != sq_ring_)
+		{
+			munmap(cq_ring_, cq_ring_size_);
+		}
+		if (sq_ring_ != MAP_FAILED)
+		{
+			munmap(sq_ring_, sq_ring_size_);
+		}
+		if (ring_ >= 0)
+		{
+			::close(ring_);
+		}
+	}
+};
+#endif
+
+
+//  ;  io_uring  ( ,  ,   ) - 
+inline std::unique_ptr<IoEngine> make_io_engine(IoEngineKind kind, const std::filesystem::path& path, bool is_write, unsigned queue_depth = 64)
+{
+#ifdef VECTOR_FILE_IO_URING
+	if (kind == IoEngineKind::uring)
+	{
+		try
+		{
+			return std::make_unique<UringEngine>(path, is_write, queue_depth);
+		}
+		catch (const std::runtime_error&)
+		{
+		}
+	}
+#endif
+	return std::make_unique<PositionalEngine>(path, is_write);
+}
@@ -0,0 +1,657 @@
+#pragma once
+#include <vector>
+#include <span>
+#include <cstring>
+#include <cstdint>
+#include <bit>
+#include <concepts>
+#include <algorithm>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VECTOR_FILE_SSE2
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define VECTOR_FILE_AVX2
+#endif
+
+
+// :      . encode  out ,
+//decode  dst.size() . id        .
+template <typename C, typename T>
+concept BlockCodec = requires(std::span<const T> elems, std::vector<char>& out, std::span<const char> bytes, std::span<T> dst)
+{
+	{ C::id } -> std::convertible_to<uint8_t>;
+	C::encode(elems, out);
+	C::decode(bytes, dst);
+};
+
+
+// : sizeof(T)   
+template <typename T>
+	requires std::is_trivially_copyable_v<T>
+struct RawCodec
+{
+	static constexpr uint8_t id = 0;
+
+	static void encode(std::span<const T> elems, std::vector<char>& out)
+	{
+		out.resize(elems.size_bytes());
+		if (!elems.empty())
+		{
+			std::memcpy(out.data(), elems.data(), elems.size_bytes());
+		}
+	}
+
+	static void decode(std::span<const char> bytes, std::span<T> dst)
+	{
+		if (!dst.empty())
+		{
+			std::memcpy(dst.data(), bytes.data(), dst.size_bytes());
+		}
+	}
+};
+
+
+//   width  ,   
+class BitWriter final
+{
+	std::vector<char>& out_;	// 
+	uint64_t acc_ = 0;			//   
+	unsigned filled_ = 0;		//   acc_
+
+public:
+	explicit BitWriter(std::vector<char>& out) : out_(out) { }
+
+	void put(uint64_t value, unsigned width)
+	{
+		while (width > 0)
+		{
+			const unsigned take = width < 32 ? width : 32;
+			acc_ |= (value & ((uint64_t(1) << take) - 1)) << filled_;
+			filled_ += take;
+			value >>= take;
+			width -= take;
+			while (filled_ >= 8)
+			{
+				out_.push_back(static_cast<char>(acc_ & 0xFF));
+				acc_ >>= 8;
+				filled_ -= 8;
+			}
+		}
+	}
+
+	void finish()
+	{
+		if (filled_ > 0)
+		{
+			out_.push_back(static_cast<char>(acc_ & 0xFF));
+			acc_ = 0;
+			filled_ = 0;
+		}
+	}
+};
+
+class BitReader final
+{
+	const unsigned char* data_;	// 
+	uint64_t acc_ = 0;			//,    
+	unsigned filled_ = 0;		//   acc_
+
+public:
+	explicit BitReader(const char* data) : data_(reinterpret_cast<const unsigned char*>(data)) { }
+
+	uint64_t get(unsigned width)
+	{
+		uint64_t value = 0;
+		unsigned done = 0;
+		while (done < width)
+		{
+			const unsigned take = width - done < 32 ? width - done : 32;
+			while (filled_ < take)
+			{
+				acc_ |= uint64_t(*data_++) << filled_;
+				filled_ += 8;
+			}
+			value |= (acc_ & ((uint64_t(1) << take) - 1)) << done;
+			acc_ >>= take;
+			filled_ -= take;
+			done += take;
+		}
+		return value;
+	}
+};
+
+
+//    zigzag-,      .
+//:   (sizeof(T) ),  (1 ), .
+template <std::integral T>
+	requires (!std::is_same_v<T, bool>)
+struct DeltaCodec
+{
+	using U = std::make_unsigned_t<T>;
+	static constexpr uint8_t id = 1;
+	static constexpr unsigned bits_ = sizeof(T) * 8;
+
+	static U zigzag(U delta) noexcept
+	{
+		return static_cast<U>(delta << 1) ^ static_cast<U>(U(0) - (delta >> (bits_ - 1)));
+	}
+
+	static U unzigzag(U value) noexcept
+	{
+		return static_cast<U>(value >> 1) ^ static_cast<U>(U(0) - (value & 1));
+	}
+
+	static void encode(std::span<const T> elems, std::vector<char>& out)
+	{
+		out.clear();
+		if (elems.empty())
+		{
+			return;
+		}
+		U widest = 0;
+		for (size_t i = 1; i < elems.size(); i++)
+		{
+			widest |= zigzag(static_cast<U>(static_cast<U>(elems[i]) - static_cast<U>(elems[i - 1])));
+		}
+		const unsigned width = static_cast<unsigned>(std::bit_width(widest));
+		out.resize(sizeof(T) + 1);
+		std::memcpy(out.data(), &elems[0], sizeof(T));
+		out[sizeof(T)] = static_cast<char>(width);
+		if (width == 0)
+		{
+			return;
+		}
+		out.reserve(out.size() + (elems.size() * width + 7) / 8);
+		BitWriter writer(out);
+		for (size_t i = 1; i < elems.size(); i++)
+		{
+			writer.put(zigzag(static_cast<U>(static_cast<U>(elems[i]) - static_cast<U>(elems[i - 1]))), width);
+		}
+		writer.finish();
+	}
+
+	static void decode(std::span<const char> bytes, std::span<T> dst)
+	{
+		if (dst.empty())
+		{
+			return;
+		}
+		U value;
+		std::memcpy(&value, bytes.data(), sizeof(T));
+		const unsigned width = static_cast<unsigned char>(bytes[sizeof(T)]);
+		dst[0] = static_cast<T>(value);
+		BitReader reader(bytes.data() + sizeof(T) + 1);
+		for (size_t i = 1; i < dst.size(); i++)
+		{
+			if (width > 0)
+			{
+				value = static_cast<U>(value + unzigzag(static_cast<U>(reader.get(width))));
+			}
+			dst[i] = static_cast<T>(value);
+		}
+	}
+};
+
+
+//  128     128-  ( SIMD-BP128):  k  
+//  k % lanes,   -   U  width   ,  w    .
+//SSE2     ,      ,     
+// .     BitWriter.      reference.
+template <std::unsigned_integral U>
+	requires (sizeof(U) == 4 || sizeof(U) == 8)
+class LanePacker final
+{
+	static constexpr size_t lanes_ = 16 / sizeof(U);		//  128- 
+	static constexpr unsigned bits_ = sizeof(U) * 8;		//  
+	static constexpr size_t group_ = lanes_ * bits_;		//   (128)
+
+public:
+	//   ()
+	static size_t packed_size(size_t count, unsigned width) noexcept
+	{
+		return count / group_ * width * 16 + (count % group_ * width + 7) / 8;
+	}
+
+	static void pack(const U* in, size_t count, unsigned width, U reference, std::vector<char>& out)
+	{
+		if (width == 0)
+		{
+			return;
+		}
+		const size_t groups = count / group_;
+		size_t position = out.size();
+		out.resize(position + groups * width * 16);
+		for (size_t group = 0; group < groups; group++)
+		{
+			pack_group(in + group * group_, width, reference, out.data() + position);
+			position += width * 16;
+		}
+		BitWriter writer(out);
+		for (size_t i = groups * group_; i < count; i++)
+		{
+			writer.put(static_cast<U>(in[i] - reference), width);
+		}
+		writer.finish();
+	}
+
+	static void unpack(const char* in, size_t count, unsigned width, U reference, U* out)
+	{
+		if (width == 0)
+		{
+			std::fill(out, out + count, reference);
+			return;
+		}
+		const size_t groups = count / group_;
+		for (size_t group = 0; group < groups; group++)
+		{
+			unpack_group(in, width, reference, out + group * group_);
+			in += width * 16;
+		}
+		BitReader reader(in);
+		for (size_t i = groups * group_; i < count; i++)
+		{
+			out[i] = static_cast<U>(static_cast<U>(reader.get(width)) + reference);
+		}
+	}
+
+private:
+	static U mask(unsigned width) noexcept
+	{
+		return width == bits_ ? static_cast<U>(~U(0)) : static_cast<U>((U(1) << width) - 1);
+	}
+
+#ifdef VECTOR_FILE_SSE2
+	static __m128i shift_left(__m128i value, unsigned count) noexcept
+	{
+		if constexpr (sizeof(U) == 4)
+		{
+			return _mm_sll_epi32(value, _mm_cvtsi32_si128(static_cast<int>(count)));
+		}
+		else
+		{
+			return _mm_sll_epi64(value, _mm_cvtsi32_si128(static_cast<int>(count)));
+		}
+	}
+
+	static __m128i shift_right(__m128i value, unsigned count) noexcept
+	{
+		if constexpr (sizeof(U) == 4)
+		{
+			return _mm_srl_epi32(value, _mm_cvtsi32_si128(static_cast<int>(count)));
+		}
+		else
+		{
+			return _mm_srl_epi64(value, _mm_cvtsi32_si128(static_cast<int>(count)));
+		}
+	}
+
+	static __m128i broadcast(U value) noexcept
+	{
+		if constexpr (sizeof(U) == 4)
+		{
+			return _mm_set1_epi32(static_cast<int>(value));
+		}
+		else
+		{
+			return _mm_set1_epi64x(static_cast<long long>(value));
+		}
+	}
+
+	static __m128i subtract(__m128i a, __m128i b) noexcept
+	{
+		if constexpr (sizeof(U) == 4)
+		{
+			return _mm_sub_epi32(a, b);
+		}
+		else
+		{
+			return _mm_sub_epi64(a, b);
+		}
+	}
+
+	static __m128i add(__m128i a, __m128i b) noexcept
+	{
+		if constexpr (sizeof(U) == 4)
+		{
+			return _mm_add_epi32(a, b);
+		}
+		else
+		{
+			return _mm_add_epi64(a, b);
+		}
+	}
+
+	static void pack_group(const U* in, unsigned width, U reference, char* out) noexcept
+	{
+		const __m128i base = broadcast(reference);
+		__m128i acc = _mm_setzero_si128();
+		unsigned filled = 0;
+		for (size_t k = 0; k < bits_; k++)
+		{
+			const __m128i value = subtract(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + k * lanes_)), base);
+			acc = _mm_or_si128(acc, shift_left(value, filled));
+			filled += width;
+			if (filled >= bits_)
+			{
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out), acc);
+				out += 16;
+				filled -= bits_;
+				acc = filled > 0 ? shift_right(value, width - filled) : _mm_setzero_si128();
+			}
+		}
+	}
+
+	static void unpack_group(const char* in, unsigned width, U reference, U* out) noexcept
+	{
+		const __m128i base = broadcast(reference);
+		const __m128i bits = broadcast(mask(width));
+		__m128i word = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+		unsigned filled = 0;
+		for (size_t k = 0; k < bits_; k++)
+		{
+			__m128i value = shift_right(word, filled);
+			filled += width;
+			if (filled >= bits_)
+			{
+				filled -= bits_;
+				if (filled > 0)
+				{
+					in += 16;
+					word = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+					value = _mm_or_si128(value, shift_left(word, width - filled));
+				}
+				else if (k + 1 < bits_)
+				{
+					in += 16;
+					word = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+				}
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + k * lanes_), add(_mm_and_si128(value, bits), base));
+		}
+	}
+#else
+	static void pack_group(const U* in, unsigned width, U reference, char* out) noexcept
+	{
+		for (size_t lane = 0; lane < lanes_; lane++)
+		{
+			char* word = out + lane * sizeof(U);
+			U acc = 0;
+			unsigned filled = 0;
+			for (size_t k = 0; k < bits_; k++)
+			{
+				const U value = static_cast<U>(in[k * lanes_ + lane] - reference);
+				acc |= static_cast<U>(value << filled);
+				filled += width;
+				if (filled >= bits_)
+				{
+					std::memcpy(word, &acc, sizeof(U));
+					word += 16;
+					filled -= bits_;
+					acc = filled > 0 ? static_cast<U>(value >> (width - filled)) : U(0);
+				}
+			}
+		}
+	}
+
+	static void unpack_group(const char* in, unsigned width, U reference, U* out) noexcept
+	{
+		const U bits = mask(width);
+		for (size_t lane = 0; lane < lanes_; lane++)
+		{
+			const char* next = in + lane * sizeof(U);
+			U word;
+			std::memcpy(&word, next, sizeof(U));
+			unsigned filled = 0;
+			for (size_t k = 0; k < bits_; k++)
+			{
+				U value = static_cast<U>(word >> filled);
+				filled += width;
+				if (filled >= bits_)
+				{
+					filled -= bits_;
+					if (filled > 0 || k + 1 < bits_)
+					{
+						next += 16;
+						std::memcpy(&word, next, sizeof(U));
+					}
+					if (filled > 0)
+					{
+						value |= static_cast<U>(word << (width - filled));
+					}
+				}
+				out[k * lanes_ + lane] = static_cast<U>((value & bits) + reference);
+			}
+		}
+	}
+#endif
+};
+
+
+//  (frame of reference):     ,  
+// ,   max - min. :  (sizeof(T) ),  (1 ), .
+template <std::integral T>
+	requires (sizeof(T) == 4 || sizeof(T) == 8)
+struct ForCodec
+{
+	using U = std::make_unsigned_t<T>;
+	static constexpr uint8_t id = 2;
+
+	static void encode(std::span<const T> elems, std::vector<char>& out)
+	{
+		out.clear();
+		if (elems.empty())
+		{
+			return;
+		}
+		T low;
+		T high;
+		range(elems, low, high);
+		const unsigned width = static_cast<unsigned>(std::bit_width(static_cast<U>(static_cast<U>(high) - static_cast<U>(low))));
+		out.resize(sizeof(T) + 1);
+		std::memcpy(out.data(), &low, sizeof(T));
+		out[sizeof(T)] = static_cast<char>(width);
+		out.reserve(out.size() + LanePacker<U>::packed_size(elems.size(), width));
+		LanePacker<U>::pack(reinterpret_cast<const U*>(elems.data()), elems.size(), width, static_cast<U>(low), out);
+	}
+
+	static void decode(std::span<const char> bytes, std::span<T> dst)
+	{
+		if (dst.empty())
+		{
+			return;
+		}
+		U low;
+		std::memcpy(&low, bytes.data(), sizeof(T));
+		const unsigned width = static_cast<unsigned char>(bytes[sizeof(T)]);
+		LanePacker<U>::unpack(bytes.data() + sizeof(T) + 1, dst.size(), width, low, reinterpret_cast<U*>(dst.data()));
+	}
+
+	//   ;  32-   AVX2 -    
+	static void range(std::span<const T> elems, T& low, T& high) noexcept
+	{
+		low = elems[0];
+		high = elems[0];
+		size_t i = 0;
+#ifdef VECTOR_FILE_AVX2
+		if constexpr (sizeof(T) == 4)
+		{
+			if (elems.size() >= 8)
+			{
+				__m256i min = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(elems.data()));
+				__m256i max = min;
+				for (i = 8; i + 8 <= elems.size(); i += 8)
+				{
+					const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(elems.data() + i));
+					if constexpr (std::is_signed_v<T>)
+					{
+						min = _mm256_min_epi32(min, value);
+						max = _mm256_max_epi32(max, value);
+					}
+					else
+					{
+						min = _mm256_min_epu32(min, value);
+						max = _mm256_max_epu32(max, value);
+					}
+				}
+				alignas(32) T lows[8];
+				alignas(32) T highs[8];
+				_mm256_store_si256(reinterpret_cast<__m256i*>(lows), min);
+				_mm256_store_si256(reinterpret_cast<__m256i*>(highs), max);
+				low = *std::min_element(lows, lows + 8);
+				high = *std::max_element(highs, highs + 8);
+			}
+		}
+#endif
+		for (; i < elems.size(); i++)
+		{
+			low = std::min(low, elems[i]);
+			high = std::max(high, elems[i]);
+		}
+	}
+};
+
+
+//   (delta-of-delta)        .
+//:  ,   ( sizeof(T) ),  (1 ), zigzag-  .
+template <std::integral T>
+	requires (sizeof(T) == 4 || sizeof(T) == 8)
+struct DeltaDeltaCodec
+{
+	using U = std::make_unsigned_t<T>;
+	static constexpr uint8_t id = 3;
+
+	static void encode(std::span<const T> elems, std::vector<char>& out)
+	{
+		out.clear();
+		if (elems.empty())
+		{
+			return;
+		}
+		const U* in = reinterpret_cast<const U*>(elems.data());
+		const U first = elems.size() > 1 ? static_cast<U>(in[1] - in[0]) : U(0);
+		std::vector<U> residuals(elems.size() > 2 ? elems.size() - 2 : 0);
+		U widest = 0;
+		for (size_t i = 2; i < elems.size(); i++)
+		{
+			const U delta = static_cast<U>(static_cast<U>(in[i] - in[i - 1]) - static_cast<U>(in[i - 1] - in[i - 2]));
+			residuals[i - 2] = DeltaCodec<T>::zigzag(delta);
+			widest |= residuals[i - 2];
+		}
+		const unsigned width = static_cast<unsigned>(std::bit_width(widest));
+		out.resize(2 * sizeof(T) + 1);
+		std::memcpy(out.data(), in, sizeof(T));
+		std::memcpy(out.data() + sizeof(T), &first, sizeof(T));
+		out[2 * sizeof(T)] = static_cast<char>(width);
+		out.reserve(out.size() + LanePacker<U>::packed_size(residuals.size(), width));
+		LanePacker<U>::pack(residuals.data(), residuals.size(), width, U(0), out);
+	}
+
+	static void decode(std::span<const char> bytes, std::span<T> dst)
+	{
+		if (dst.empty())
+		{
+			return;
+		}
+		U* out = reinterpret_cast<U*>(dst.data());
+		U delta;
+		std::memcpy(out, bytes.data(), sizeof(T));
+		std::memcpy(&delta, bytes.data() + sizeof(T), sizeof(T));
+		if (dst.size() == 1)
+		{
+			return;
+		}
+		out[1] = static_cast<U>(out[0] + delta);
+		const unsigned width = static_cast<unsigned char>(bytes[2 * sizeof(T)]);
+		//    ,   ,    
+		LanePacker<U>::unpack(bytes.data() + 2 * sizeof(T) + 1, dst.size() - 2, width, U(0), out + 2);
+		for (size_t i = 2; i < dst.size(); i++)
+		{
+			delta = static_cast<U>(delta + DeltaCodec<T>::unzigzag(out[i]));
+			out[i] = static_cast<U>(out[i - 1] + delta);
+		}
+	}
+};
+
+
+//XOR     :      ,     ,
+//     . :  ,  (1 ),  (1 ),  XOR.
+template <std::floating_point T>
+	requires (sizeof(T) == 4 || sizeof(T) == 8)
+struct XorCodec
+{
+	using U = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+	static constexpr uint8_t id = 4;
+
+	static void encode(std::span<const T> elems, std::vector<char>& out)
+	{
+		out.clear();
+		if (elems.empty())
+		{
+			return;
+		}
+		std::vector<U> residuals(elems.size() - 1);
+		U previous = std::bit_cast<U>(elems[0]);
+		U any = 0;
+		for (size_t i = 1; i < elems.size(); i++)
+		{
+			const U current = std::bit_cast<U>(elems[i]);
+			residuals[i - 1] = current ^ previous;
+			any |= residuals[i - 1];
+			previous = current;
+		}
+		const unsigned shift = any == 0 ? 0 : static_cast<unsigned>(std::countr_zero(any));
+		const unsigned width = static_cast<unsigned>(std::bit_width(static_cast<U>(any >> shift)));
+		for (U& residual : residuals)
+		{
+			residual >>= shift;
+		}
+		out.resize(sizeof(T) + 2);
+		std::memcpy(out.data(), elems.data(), sizeof(T));
+		out[sizeof(T)] = static_cast<char>(shift);
+		out[sizeof(T) + 1] = static_cast<char>(width);
+		out.reserve(out.size() + LanePacker<U>::packed_size(residuals.size(), width));
+		LanePacker<U>::pack(residuals.data(), residuals.size(), width, U(0), out);
+	}
+
+	static void decode(std::span<const char> bytes, std::span<T> dst)
+	{
+		if (dst.empty())
+		{
+			return;
+		}
+		U previous;
+		std::memcpy(&previous, bytes.data(), sizeof(T));
+		const unsigned shift = static_cast<unsigned char>(bytes[sizeof(T)]);
+		const unsigned width = static_cast<unsigned char>(bytes[sizeof(T) + 1]);
+		std::vector<U> residuals(dst.size() - 1);
+		LanePacker<U>::unpack(bytes.data() + sizeof(T) + 2, residuals.size(), width, U(0), residuals.data());
+		dst[0] = std::bit_cast<T>(previous);
+		for (size_t i = 1; i < dst.size(); i++)
+		{
+			previous ^= static_cast<U>(residuals[i - 1] << shift);
+			dst[i] = std::bit_cast<T>(previous);
+		}
+	}
+};
+
+
+//  :   ,   
+template <typename T>
+struct DefaultCodecFor
+{
+	using type = RawCodec<T>;
+};
+
+template <std::integral T>
+	requires (!std::is_same_v<T, bool>)
+struct DefaultCodecFor<T>
+{
+	using type = DeltaCodec<T>;
+};
+
+template <typename T>
+using DefaultCodec = typename DefaultCodecFor<T>::type;
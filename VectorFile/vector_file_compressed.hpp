@@ -0,0 +1,291 @@
+#pragma once
+#include <fstream>
+#include <vector>
+#include <span>
+#include <cstdint>
+#include <algorithm>
+#include <filesystem>
+#include "VectorFile.hpp"
+#include "file_handle.hpp"
+#include "vector_file_codec.hpp"
+#include "vector_file_exception.hpp"
+
+
+//     .      block_elems ,   
+// C      ;   <path>.blk   ,  ,
+//       .  -   :    
+//   ,         flush(). , 
+//      ,     .    , 
+//  ,  ,     ,   .
+template <Acceptable T, class C = DefaultCodec<T>>
+	requires BlockCodec<C, T>
+class CompressedVectorFile final
+{
+	struct TableHeader
+	{
+		uint64_t count;			// 
+		uint64_t block_elems;	//  ()
+		uint64_t type_size;		//sizeof(T)
+		uint64_t codec;			//C::id
+		uint64_t block_size;	//sizeof(Block),   
+	};
+
+	struct Block
+	{
+		uint64_t offset;	//     ()
+		uint64_t size;		//   ()
+		uint64_t capacity;	//      (),   size
+	};
+
+	static const size_t type_size_ = sizeof(T);	//  ()
+	static constexpr size_t no_block_ = static_cast<size_t>(-1);
+
+	std::filesystem::path path_;		//   
+	std::filesystem::path table_path_;	//   
+	bool is_write_;						// -/
+	FileHandle data_;					// 
+	size_t count_ = 0;					// 
+	size_t block_elems_;				//  ()
+	std::vector<Block> blocks_;			// 
+	size_t data_size_ = 0;				//   ()
+	size_t window_block_ = no_block_;	//,   
+	std::vector<T> window_;				// 
+	bool dirty_ = false;				// 
+	bool table_dirty_ = false;			// 
+	std::vector<char> encoded_;			// 
+
+public:
+	//       ,  .        .
+	explicit CompressedVectorFile(std::filesystem::path path, bool is_write = false, size_t block_elems = 4096)
+		: path_(std::move(path)), is_write_(is_write), block_elems_(std::max<size_t>(1, block_elems))
+	{
+		table_path_ = path_;
+		table_path_ += ".blk";
+		if (is_write_ && !std::filesystem::exists(path_))
+		{
+			std::ofstream(path_, std::ios::binary).close();
+			table_dirty_ = true;
+		}
+		else
+		{
+			read_table();
+		}
+		data_ = FileHandle(path_, is_write_);
+		data_size_ = data_.size();
+	}
+
+	//       ;   ,   flush()  
+	~CompressedVectorFile()
+	{
+		try
+		{
+			close();
+		}
+		catch (...)
+		{
+		}
+	}
+
+	CompressedVectorFile(CompressedVectorFile&&) noexcept = default;
+	CompressedVectorFile& operator=(CompressedVectorFile&&) = default;
+
+	CompressedVectorFile(const CompressedVectorFile&) = delete;
+	CompressedVectorFile& operator=(const CompressedVectorFile&) = delete;
+
+	size_t size() const noexcept
+	{
+		return count_;
+	}
+
+	//     ()
+	size_t size_file() const noexcept
+	{
+		return data_size_;
+	}
+
+	size_t size_buffer() const noexcept
+	{
+		return block_elems_;
+	}
+
+	const std::filesystem::path& path() const noexcept
+	{
+		return path_;
+	}
+
+	T& operator[](size_t index)
+	{
+		check(index);
+		seek_window(index / block_elems_);
+		dirty_ = dirty_ || is_write_;
+		return window_[index % block_elems_];
+	}
+
+	T get(size_t index)
+	{
+		check(index);
+		seek_window(index / block_elems_);
+		return window_[index % block_elems_];
+	}
+
+	//   ;       
+	void push_back(const T& value)
+	{
+		if (!is_write_)
+		{
+			throw write_error();
+		}
+		seek_window(count_ / block_elems_);
+		window_.push_back(value);
+		dirty_ = true;
+		++count_;
+		table_dirty_ = true;
+	}
+
+	T pop_back()
+	{
+		if (!is_write_)
+		{
+			throw write_error();
+		}
+		if (count_ == 0)
+		{
+			throw goind_out_of_file();
+		}
+		seek_window((count_ - 1) / block_elems_);
+		T value = std::move(window_.back());
+		window_.pop_back();
+		dirty_ = true;
+		--count_;
+		table_dirty_ = true;
+		return value;
+	}
+
+	//      ;      
+	void flush()
+	{
+		if (!is_write_)
+		{
+			throw write_error();
+		}
+		write_window();
+		if (!table_dirty_)
+		{
+			return;
+		}
+		if (data_.size() > data_size_)
+		{
+			data_.resize(data_size_);
+		}
+		std::ofstream table(table_path_, std::ios::binary | std::ios::trunc);
+		const TableHeader header{ count_, block_elems_, type_size_, C::id, sizeof(Block) };
+		table.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		table.write(reinterpret_cast<const char*>(blocks_.data()), blocks_.size() * sizeof(Block));
+		if (!table)
+		{
+			throw std::runtime_error("Could not write block table.");
+		}
+		table_dirty_ = false;
+	}
+
+private:
+	void close()
+	{
+		if (is_write_ && data_.is_open())
+		{
+			flush();
+		}
+	}
+
+	void check(size_t index) const
+	{
+		if (index >= count_)
+		{
+			throw goind_out_of_file();
+		}
+	}
+
+	void read_table()
+	{
+		std::ifstream table(table_path_, std::ios::binary);
+		TableHeader header{};
+		if (!table.read(reinterpret_cast<char*>(&header), sizeof(header)))
+		{
+			throw std::runtime_error("File does not exist or could not be opened for reading.");
+		}
+		if (header.type_size != type_size_ || header.codec != C::id || header.block_elems == 0 || header.block_size != sizeof(Block))
+		{
+			throw format_mismatch();
+		}
+		count_ = header.count;
+		block_elems_ = header.block_elems;
+		blocks_.resize((count_ + block_elems_ - 1) / block_elems_);
+		if (!table.read(reinterpret_cast<char*>(blocks_.data()), blocks_.size() * sizeof(Block)))
+		{
+			throw format_mismatch();
+		}
+	}
+
+	void seek_window(size_t block)
+	{
+		if (block == window_block_)
+		{
+			return;
+		}
+		write_window();
+		window_block_ = block;
+		const size_t first = block * block_elems_;
+		window_.reserve(block_elems_);
+		window_.resize(std::min(block_elems_, count_ - std::min(first, count_)));
+		if (block < blocks_.size() && !window_.empty())
+		{
+			encoded_.resize(blocks_[block].size);
+			data_.read_at(blocks_[block].offset, encoded_.data(), encoded_.size());
+			C::decode(std::span<const char>(encoded_), std::span<T>(window_));
+		}
+	}
+
+	void write_window()
+	{
+		if (!dirty_)
+		{
+			return;
+		}
+		dirty_ = false;
+		table_dirty_ = true;
+		if (window_.empty())
+		{
+			//    pop_back
+			if (window_block_ < blocks_.size())
+			{
+				const Block& block = blocks_[window_block_];
+				if (block.offset + block.capacity == data_size_)
+				{
+					data_size_ = block.offset;
+				}
+				blocks_.resize(window_block_);
+			}
+			return;
+		}
+		C::encode(std::span<const T>(window_), encoded_);
+		if (window_block_ >= blocks_.size())
+		{
+			blocks_.resize(window_block_ + 1, Block{ 0, 0, 0 });
+		}
+		Block& block = blocks_[window_block_];
+		if (block.capacity > 0 && block.offset + block.capacity == data_size_)
+		{
+			//          
+			data_size_ = block.offset + encoded_.size();
+			block.capacity = encoded_.size();
+		}
+		else if (encoded_.size() > block.capacity)
+		{
+			block.offset = data_size_;
+			data_size_ += encoded_.size();
+			block.capacity = encoded_.size();
+		}
+		block.size = encoded_.size();
+		data_.write_at(block.offset, encoded_.data(), encoded_.size());
+	}
+};
@@ -0,0 +1,309 @@
+#pragma once
+#include <vector>
+#include <span>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+#include <algorithm>
+#include <filesystem>
+#include "VectorFile.hpp"
+#include "file_handle.hpp"
+#include "vector_file_exception.hpp"
+
+
+//       .      (stripes):
+// p   p % stripes  ,       ,
+// ,     ,   .   -  .
+//   (VectorFileHeader)  :    ,    ,
+// flush()          .
+template <Acceptable T, class S = Serializer<T>>
+	requires BulkSerializer<S, T>
+class ConcurrentVectorFile final
+{
+	static const size_t type_size_ = sizeof(T);	//  ()
+	static constexpr bool raw_ = std::is_trivially_copyable_v<T> && std::is_same_v<S, Serializer<T>>;
+
+	struct Page
+	{
+		std::vector<T> buffer;		// 
+		size_t dirty_first = 0;		//   ()
+		size_t dirty_last = 0;		//   (,  )
+		size_t last_use = 0;		//   ( LRU  )
+	};
+
+	struct Stripe
+	{
+		std::mutex mutex;
+		std::unordered_map<size_t, Page> pages;	//  -> 
+		size_t clock = 0;						//   LRU
+		std::vector<char> bytes;				//   
+	};
+
+	std::filesystem::path path_;		//  
+	FileHandle handle_;					// ,    
+	size_t window_elems_;				//  ()
+	size_t pages_per_stripe_;			//  ()
+	std::atomic<size_t> size_;			// 
+	std::atomic<size_t> disk_size_;		//   ,   ()
+	size_t data_offset_ = 0;			//    :    0 ()
+	std::vector<Stripe> stripes_;		//  
+
+public:
+	explicit ConcurrentVectorFile(std::filesystem::path path, size_t window_size = 1024, size_t stripes = 64, size_t cache_pages = 1024)
+		: path_(std::move(path)), handle_(path_, true), window_elems_(std::max<size_t>(1, window_size / type_size_)),
+		pages_per_stripe_(std::max<size_t>(1, cache_pages / std::max<size_t>(1, stripes))), stripes_(std::max<size_t>(1, stripes))
+	{
+		VectorFileHeader header;
+		if (VectorFileHeader::read<T, S>(handle_, header))
+		{
+			data_offset_ = VectorFileHeader::size;
+			size_ = header.count;
+			//      pop_back/resize      
+			if (handle_.size() > data_offset_ + size_ * type_size_)
+			{
+				handle_.resize(data_offset_ + size_ * type_size_);
+			}
+			disk_size_ = handle_.size() - data_offset_;
+		}
+		else
+		{
+			disk_size_ = handle_.size();
+			size_ = disk_size_ / type_size_;
+		}
+	}
+
+	//       ;   ,   flush()  
+	~ConcurrentVectorFile()
+	{
+		try
+		{
+			close();
+		}
+		catch (...)
+		{
+		}
+	}
+
+	ConcurrentVectorFile(const ConcurrentVectorFile&) = delete;
+	ConcurrentVectorFile& operator=(const ConcurrentVectorFile&) = delete;
+
+	size_t size_file() const noexcept
+	{
+		return size_ * type_size_;
+	}
+
+	//    :    0 ()
+	size_t data_offset() const noexcept
+	{
+		return data_offset_;
+	}
+
+	T load(size_t index)
+	{
+		check(index);
+		return access(index, false, [](T& elem) { return elem; });
+	}
+
+	void store(size_t index, const T& value)
+	{
+		check(index);
+		access(index, true, [&value](T& elem) { elem = value; });
+	}
+
+	//   : fn(T&)    
+	template <class Fn>
+	void update(size_t index, Fn fn)
+	{
+		check(index);
+		access(index, true, [&fn](T& elem) { fn(elem); });
+	}
+
+	//   ;    
+	size_t push_back(const T& value)
+	{
+		const size_t index = size_.fetch_add(1);
+		access(index, true, [&value](T& elem) { elem = value; });
+		return index;
+	}
+
+	//  .    ,      :
+	// ,   , ,  ,    flush,   .
+	void flush()
+	{
+		std::vector<std::unique_lock<std::mutex>> locks;
+		locks.reserve(stripes_.size());
+		for (Stripe& stripe : stripes_)
+		{
+			locks.emplace_back(stripe.mutex);
+		}
+		for (Stripe& stripe : stripes_)
+		{
+			for (auto& [page, entry] : stripe.pages)
+			{
+				write(stripe, page, entry);
+			}
+		}
+		const size_t bytes = size_ * type_size_;
+		if (disk_size_ < bytes)
+		{
+			handle_.resize(data_offset_ + bytes);
+			disk_size_ = bytes;
+		}
+		if (data_offset_ > 0)
+		{
+			VectorFileHeader::write<T, S>(handle_, size_, window_elems_ * type_size_);
+		}
+	}
+
+	// ; ,       
+	void resize(size_t new_file_size)
+	{
+		const size_t count = new_file_size / type_size_;
+		for (Stripe& stripe : stripes_)
+		{
+			std::lock_guard lock(stripe.mutex);
+			for (auto iter = stripe.pages.begin(); iter != stripe.pages.end();)
+			{
+				const size_t first = iter->first * window_elems_;
+				if (first >= count)
+				{
+					iter = stripe.pages.erase(iter);
+					continue;
+				}
+				Page& entry = iter->second;
+				const size_t keep = count - first;
+				if (keep < entry.buffer.size())
+				{
+					std::fill(entry.buffer.begin() + keep, entry.buffer.end(), T{});
+					entry.dirty_last = std::min(entry.dirty_last, keep);
+				}
+				++iter;
+			}
+		}
+		size_ = count;
+		if (disk_size_ > count * type_size_)
+		{
+			handle_.resize(data_offset_ + count * type_size_);
+			disk_size_ = count * type_size_;
+		}
+	}
+
+private:
+	void close()
+	{
+		flush();
+		if (data_offset_ == 0 && handle_.size() > size_ * type_size_)
+		{
+			handle_.resize(size_ * type_size_);
+		}
+	}
+
+	void check(size_t index) const
+	{
+		if (index >= size_)
+		{
+			throw goind_out_of_file();
+		}
+	}
+
+	template <class Fn>
+	decltype(auto) access(size_t index, bool modify, Fn fn)
+	{
+		const size_t page = index / window_elems_;
+		const size_t position = index - page * window_elems_;
+		Stripe& stripe = stripes_[page % stripes_.size()];
+		std::lock_guard lock(stripe.mutex);
+		Page& entry = fetch(stripe, page);
+		entry.last_use = ++stripe.clock;
+		if (modify)
+		{
+			if (entry.dirty_first >= entry.dirty_last)
+			{
+				entry.dirty_first = position;
+				entry.dirty_last = position + 1;
+			}
+			else
+			{
+				entry.dirty_first = std::min(entry.dirty_first, position);
+				entry.dirty_last = std::max(entry.dirty_last, position + 1);
+			}
+		}
+		return fn(entry.buffer[position]);
+	}
+
+	// ;     ,      
+	Page& fetch(Stripe& stripe, size_t page)
+	{
+		const auto found = stripe.pages.find(page);
+		if (found != stripe.pages.end())
+		{
+			return found->second;
+		}
+		std::vector<T> buffer;
+		if (stripe.pages.size() >= pages_per_stripe_)
+		{
+			auto victim = stripe.pages.begin();
+			for (auto iter = stripe.pages.begin(); iter != stripe.pages.end(); ++iter)
+			{
+				if (iter->second.last_use < victim->second.last_use)
+				{
+					victim = iter;
+				}
+			}
+			write(stripe, victim->first, victim->second);
+			buffer = std::move(victim->second.buffer);
+			stripe.pages.erase(victim);
+		}
+		Page& entry = stripe.pages[page];
+		entry.buffer = std::move(buffer);
+		entry.buffer.assign(window_elems_, T{});
+		const size_t offset = page * window_elems_ * type_size_;
+		const size_t disk = disk_size_;
+		const size_t count = offset >= disk ? 0 : std::min(window_elems_, (disk - offset) / type_size_);
+		if (count > 0)
+		{
+			read_at(stripe, offset, std::span<T>(entry.buffer.data(), count));
+		}
+		return entry;
+	}
+
+	void read_at(Stripe& stripe, size_t offset, std::span<T> elems)
+	{
+		if constexpr (raw_)
+		{
+			handle_.read_at(data_offset_ + offset, elems.data(), elems.size_bytes());
+		}
+		else
+		{
+			stripe.bytes.resize(elems.size_bytes());
+			handle_.read_at(data_offset_ + offset, stripe.bytes.data(), stripe.bytes.size());
+			S::deserialization(std::span<const char>(stripe.bytes), elems);
+		}
+	}
+
+	void write(Stripe& stripe, size_t page, Page& entry)
+	{
+		if (entry.dirty_first >= entry.dirty_last)
+		{
+			return;
+		}
+		const size_t offset = (page * window_elems_ + entry.dirty_first) * type_size_;
+		const std::span<const T> elems(entry.buffer.data() + entry.dirty_first, entry.dirty_last - entry.dirty_first);
+		if constexpr (raw_)
+		{
+			handle_.write_at(data_offset_ + offset, elems.data(), elems.size_bytes());
+		}
+		else
+		{
+			stripe.bytes.resize(elems.size_bytes());
+			S::serialization(elems, std::span<char>(stripe.bytes));
+			handle_.write_at(data_offset_ + offset, stripe.bytes.data(), stripe.bytes.size());
+		}
+		entry.dirty_first = 0;
+		entry.dirty_last = 0;
+		size_t disk = disk_size_;
+		while (disk < offset + elems.size_bytes() && !disk_size_.compare_exchange_weak(disk, offset + elems.size_bytes()))
+		{
+		}
+	}
+};
@@ -16,4 +16,36 @@ class write_error : std::exception
 	{
 		return "No write access to file";
 	}
-};
\ No newline at end of file
+};
+
+class unsupported_storage : std::exception
+{
+	char const* what() const override
+	{
+		return "Storage mode is not supported for this element type or serializer";
+	}
+};
+
+class window_pinned : std::exception
+{
+	char const* what() const override
+	{
+		return "All windows are pinned by views";
+	}
+};
+
+class format_mismatch : std::exception
+{
+	char const* what() const override
+	{
+		return "File layout does not match element type or codec";
+	}
+};
+
+class checksum_error : std::exception
+{
+	char const* what() const override
+	{
+		return "Page checksum mismatch";
+	}
+};
@@ -0,0 +1,250 @@
+#pragma once
+#include <vector>
+#include <span>
+#include <thread>
+#include <exception>
+#include <optional>
+#include <concepts>
+#include <fstream>
+#include <algorithm>
+#include <filesystem>
+#include "VectorFile.hpp"
+#include "file_handle.hpp"
+
+
+namespace vf
+{
+	//     :  -   ,
+	//   -   .
+	template <Acceptable T, class S>
+	class ChunkFile final
+	{
+		static constexpr bool bulk_ = BulkSerializer<S, T>;
+		static constexpr bool raw_ = std::is_trivially_copyable_v<T> && std::is_same_v<S, Serializer<T>>;
+
+		FileHandle handle_;				//  -
+		std::fstream file_;				//   
+		std::vector<char> bytes_;		//   
+		size_t base_;					//     (VectorFile::data_offset)
+
+	public:
+		ChunkFile(const std::filesystem::path& path, bool is_write, size_t base = 0) : base_(base)
+		{
+			if constexpr (bulk_)
+			{
+				handle_ = FileHandle(path, is_write);
+			}
+			else
+			{
+				file_.open(path, is_write ? std::ios::in | std::ios::out | std::ios::binary : std::ios::in | std::ios::binary);
+				if (!file_.is_open())
+				{
+					throw std::runtime_error("File does not exist or could not be opened for reading.");
+				}
+			}
+		}
+
+		void read(size_t first, std::span<T> elems)
+		{
+			if constexpr (raw_)
+			{
+				handle_.read_at(base_ + first * sizeof(T), elems.data(), elems.size_bytes());
+			}
+			else if constexpr (bulk_)
+			{
+				bytes_.resize(elems.size_bytes());
+				handle_.read_at(base_ + first * sizeof(T), bytes_.data(), bytes_.size());
+				S::deserialization(std::span<const char>(bytes_), elems);
+			}
+			else
+			{
+				file_.clear();
+				file_.seekg(base_ + first * sizeof(T), std::ios::beg);
+				for (T& elem : elems)
+				{
+					S::deserialization(file_, elem);
+				}
+			}
+		}
+
+		void write(size_t first, std::span<T> elems)
+		{
+			if constexpr (raw_)
+			{
+				handle_.write_at(base_ + first * sizeof(T), elems.data(), elems.size_bytes());
+			}
+			else if constexpr (bulk_)
+			{
+				bytes_.resize(elems.size_bytes());
+				S::serialization(std::span<const T>(elems), std::span<char>(bytes_));
+				handle_.write_at(base_ + first * sizeof(T), bytes_.data(), bytes_.size());
+			}
+			else
+			{
+				file_.clear();
+				file_.seekp(base_ + first * sizeof(T), std::ios::beg);
+				for (T& elem : elems)
+				{
+					S::serialization(file_, elem);
+				}
+				file_.flush();
+			}
+		}
+	};
+
+
+	// [0, total)   threads  ; part(index, first, last)    .
+	//        .
+	template <class Part>
+	void run_parallel(size_t total, size_t threads, Part part)
+	{
+		if (threads == 0)
+		{
+			threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+		}
+		threads = std::max<size_t>(1, std::min(threads, total));
+		std::vector<std::exception_ptr> errors(threads);
+		std::vector<std::thread> workers;
+		for (size_t i = 0; i < threads; i++)
+		{
+			workers.emplace_back([&, i]
+			{
+				try
+				{
+					part(i, total * i / threads, total * (i + 1) / threads);
+				}
+				catch (...)
+				{
+					errors[i] = std::current_exception();
+				}
+			});
+		}
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+		for (const std::exception_ptr& error : errors)
+		{
+			if (error)
+			{
+				std::rethrow_exception(error);
+			}
+		}
+	}
+
+	// ,    ,       
+	template <Acceptable T, class S, size_t N>
+	void prepare(VectorFile<T, S, N>& vec)
+	{
+		if (vec.writable())
+		{
+			vec.flush();
+		}
+	}
+
+	constexpr size_t chunk_bytes = 1 << 20;	// ,     ()
+
+
+	//  fn(const T&)   .      .
+	template <Acceptable T, class S, size_t N, class Fn>
+	void for_each(VectorFile<T, S, N>& vec, Fn fn, size_t threads = 0)
+	{
+		prepare(vec);
+		const size_t block = std::max<size_t>(1, chunk_bytes / sizeof(T));
+		run_parallel(vec.size_file() / sizeof(T), threads, [&](size_t, size_t first, size_t last)
+		{
+			ChunkFile<T, S> file(vec.path(), false, vec.data_offset());
+			std::vector<T> buffer;
+			for (size_t pos = first; pos < last; pos += buffer.size())
+			{
+				buffer.resize(std::min(block, last - pos));
+				file.read(pos, buffer);
+				for (const T& elem : buffer)
+				{
+					fn(elem);
+				}
+			}
+		});
+	}
+
+	//  out[i] = fn(in[i]). out   in; in  out    .
+	template <Acceptable T, class S, size_t N, Acceptable U, class SU, size_t NU, class Fn>
+	void transform(VectorFile<T, S, N>& in, VectorFile<U, SU, NU>& out, Fn fn, size_t threads = 0)
+	{
+		if (!out.writable())
+		{
+			throw write_error();
+		}
+		const size_t total = in.size_file() / sizeof(T);
+		prepare(in);
+		if (static_cast<void*>(&in) != static_cast<void*>(&out))
+		{
+			out.resize(total * sizeof(U));
+			prepare(out);
+		}
+		const size_t block = std::max<size_t>(1, chunk_bytes / std::max(sizeof(T), sizeof(U)));
+		run_parallel(total, threads, [&](size_t, size_t first, size_t last)
+		{
+			ChunkFile<T, S> source(in.path(), false, in.data_offset());
+			ChunkFile<U, SU> target(out.path(), true, out.data_offset());
+			std::vector<T> buffer;
+			std::vector<U> result;
+			for (size_t pos = first; pos < last; pos += buffer.size())
+			{
+				buffer.resize(std::min(block, last - pos));
+				source.read(pos, buffer);
+				result.clear();
+				for (const T& elem : buffer)
+				{
+					result.push_back(fn(elem));
+				}
+				target.write(pos, result);
+			}
+		});
+		out.refresh();
+	}
+
+	// .    op(R, T),   init,    
+	//combine(R, R). init     (  std::reduce), combine -   .
+	template <Acceptable T, class S, size_t N, class R, class Op, class Combine>
+		requires std::invocable<Combine&, R, R>
+	R reduce(VectorFile<T, S, N>& vec, R init, Op op, Combine combine, size_t threads = 0)
+	{
+		prepare(vec);
+		const size_t total = vec.size_file() / sizeof(T);
+		const size_t block = std::max<size_t>(1, chunk_bytes / sizeof(T));
+		std::vector<std::optional<R>> partial(std::max<size_t>(1, threads == 0 ? std::thread::hardware_concurrency() : threads));
+		run_parallel(total, partial.size(), [&](size_t index, size_t first, size_t last)
+		{
+			ChunkFile<T, S> file(vec.path(), false, vec.data_offset());
+			std::vector<T> buffer;
+			R acc = init;
+			for (size_t pos = first; pos < last; pos += buffer.size())
+			{
+				buffer.resize(std::min(block, last - pos));
+				file.read(pos, buffer);
+				for (const T& elem : buffer)
+				{
+					acc = op(std::move(acc), elem);
+				}
+			}
+			partial[index] = std::move(acc);
+		});
+		std::optional<R> result;
+		for (std::optional<R>& value : partial)
+		{
+			if (value)
+			{
+				result = result ? combine(std::move(*result), std::move(*value)) : std::move(*value);
+			}
+		}
+		return result ? std::move(*result) : init;
+	}
+
+	//op   ,   
+	template <Acceptable T, class S, size_t N, class R, class Op>
+	R reduce(VectorFile<T, S, N>& vec, R init, Op op, size_t threads = 0)
+	{
+		return reduce(vec, std::move(init), op, op, threads);
+	}
+}
@@ -0,0 +1,416 @@
+#pragma once
+#include <fstream>
+#include <vector>
+#include <span>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+#include <filesystem>
+#include <concepts>
+#include "VectorFile.hpp"
+#include "file_handle.hpp"
+#include "vector_file_exception.hpp"
+
+
+//   :           
+template <typename S, typename T>
+concept RecordSerializer = requires(const T& elem, T& out, std::span<char> bytes, std::span<const char> cbytes)
+{
+	{ S::get_size_element(elem) } -> std::convertible_to<size_t>;
+	S::serialization(elem, bytes);
+	S::deserialization(cbytes, out);
+};
+
+// -      (std::string, std::vector<int>  ..)
+template <class C>
+	requires std::is_trivially_copyable_v<typename C::value_type>
+struct SequenceSerializer
+{
+	using value_type = typename C::value_type;
+
+	static size_t get_size_element(const C& elem)
+	{
+		return elem.size() * sizeof(value_type);
+	}
+
+	static void serialization(const C& elem, std::span<char> bytes)
+	{
+		if (!bytes.empty())
+		{
+			std::memcpy(bytes.data(), elem.data(), bytes.size());
+		}
+	}
+
+	static void deserialization(std::span<const char> bytes, C& elem)
+	{
+		elem.resize(bytes.size() / sizeof(value_type));
+		if (!bytes.empty())
+		{
+			std::memcpy(elem.data(), bytes.data(), bytes.size());
+		}
+	}
+};
+
+
+//     .      ,    <path>.idx:
+//        ,      .  
+// ,     - O(1),         .  
+//window_records  .      ,      ( 
+//,       ),  -     (  
+//). push_back          .   
+//   ,     ,     .
+template <Acceptable T, class S>
+	requires RecordSerializer<S, T>
+class RecordVectorFile final
+{
+	struct IndexHeader
+	{
+		uint64_t count;		// 
+		uint64_t ref_size;	//sizeof(RecordRef),   
+	};
+
+	struct RecordRef
+	{
+		uint64_t offset;	//     ()
+		uint64_t size;		//  ()
+		uint64_t capacity;	//      (),   size
+	};
+
+	static constexpr size_t header_size_ = sizeof(IndexHeader);
+	static constexpr size_t ref_size_ = sizeof(RecordRef);
+	static constexpr size_t no_record_ = static_cast<size_t>(-1);
+
+	std::filesystem::path path_;		//   
+	std::filesystem::path index_path_;	//  
+	bool is_write_;						// -/
+	FileHandle data_;					// 
+	FileHandle index_;					// 
+	MappedView index_view_;				// 
+	size_t count_ = 0;					//   
+	size_t capacity_ = 0;				//   ()
+	size_t data_size_ = 0;				//   ()
+	size_t window_records_;				//  ()
+	size_t window_first_ = no_record_;	//  
+	std::vector<T> window_;				// 
+	size_t dirty_first_ = 0;			//    ()
+	size_t dirty_last_ = 0;				//    (,  )
+	std::vector<char> append_;			// push_back,      
+	std::vector<RecordRef> pending_;	//      ( -   )
+	size_t append_capacity_;			//   ()
+	std::vector<char> bytes_;			//     
+
+public:
+	//       ,      
+	explicit RecordVectorFile(std::filesystem::path path, bool is_write = false, size_t window_records = 256, size_t append_buffer = 1 << 20)
+		: path_(std::move(path)), is_write_(is_write), window_records_(std::max<size_t>(1, window_records)), append_capacity_(append_buffer)
+	{
+		index_path_ = path_;
+		index_path_ += ".idx";
+		if (is_write_ && !std::filesystem::exists(path_))
+		{
+			std::ofstream(path_, std::ios::binary).close();
+			std::ofstream(index_path_, std::ios::binary).close();
+		}
+		data_ = FileHandle(path_, is_write_);
+		index_ = FileHandle(index_path_, is_write_);
+		data_size_ = data_.size();
+		const size_t index_size = index_.size();
+		if (index_size == 0 && is_write_)
+		{
+			index_.resize(header_size_);
+			index_view_ = index_.map(0, header_size_);
+			*header() = { 0, ref_size_ };
+			return;
+		}
+		if (index_size < header_size_)
+		{
+			throw format_mismatch();
+		}
+		capacity_ = (index_size - header_size_) / ref_size_;
+		index_view_ = index_.map(0, header_size_ + capacity_ * ref_size_);
+		if (header()->ref_size != ref_size_ || header()->count > capacity_)
+		{
+			throw format_mismatch();
+		}
+		count_ = header()->count;
+	}
+
+	//       ;   ,   flush()  
+	~RecordVectorFile()
+	{
+		try
+		{
+			close();
+		}
+		catch (...)
+		{
+		}
+	}
+
+	RecordVectorFile(RecordVectorFile&&) noexcept = default;
+	RecordVectorFile& operator=(RecordVectorFile&&) = default;
+
+	RecordVectorFile(const RecordVectorFile&) = delete;
+	RecordVectorFile& operator=(const RecordVectorFile&) = delete;
+
+	size_t size() const noexcept
+	{
+		return count_ + pending_.size();
+	}
+
+	//          ()
+	size_t size_file() const noexcept
+	{
+		return data_size_ + append_.size();
+	}
+
+	size_t size_buffer() const noexcept
+	{
+		return window_records_;
+	}
+
+	const std::filesystem::path& path() const noexcept
+	{
+		return path_;
+	}
+
+	//     ()
+	size_t record_size(size_t index)
+	{
+		check(index);
+		return index < count_ ? refs()[index].size : pending_[index - count_].size;
+	}
+
+	T& operator[](size_t index)
+	{
+		check(index);
+		seek_window(index);
+		const size_t position = index - window_first_;
+		if (is_write_)
+		{
+			if (dirty_first_ >= dirty_last_)
+			{
+				dirty_first_ = position;
+				dirty_last_ = position + 1;
+			}
+			else
+			{
+				dirty_first_ = std::min(dirty_first_, position);
+				dirty_last_ = std::max(dirty_last_, position + 1);
+			}
+		}
+		return window_[position];
+	}
+
+	T get(size_t index)
+	{
+		check(index);
+		seek_window(index);
+		return window_[index - window_first_];
+	}
+
+	void push_back(const T& value)
+	{
+		if (!is_write_)
+		{
+			throw write_error();
+		}
+		const size_t size = S::get_size_element(value);
+		const size_t offset = append_.size();
+		append_.resize(offset + size);
+		S::serialization(value, std::span<char>(append_.data() + offset, size));
+		pending_.push_back({ offset, size, size });
+		if (append_.size() >= append_capacity_)
+		{
+			flush_append();
+		}
+	}
+
+	T pop_back()
+	{
+		if (!is_write_)
+		{
+			throw write_error();
+		}
+		if (size() == 0)
+		{
+			throw goind_out_of_file();
+		}
+		if (!pending_.empty())
+		{
+			const RecordRef last = pending_.back();
+			T value{};
+			S::deserialization(std::span<const char>(append_.data() + last.offset, last.size), value);
+			append_.resize(last.offset);
+			pending_.pop_back();
+			return value;
+		}
+		T value = get(count_ - 1);
+		const RecordRef last = refs()[count_ - 1];
+		--count_;
+		header()->count = count_;
+		if (last.offset + last.capacity == data_size_)
+		{
+			data_size_ = last.offset;
+		}
+		if (window_first_ != no_record_ && window_first_ + window_.size() > count_)
+		{
+			window_.pop_back();
+			dirty_last_ = std::min(dirty_last_, window_.size());
+			if (window_.empty())
+			{
+				window_first_ = no_record_;
+			}
+		}
+		return value;
+	}
+
+	//    ;      
+	void flush()
+	{
+		if (!is_write_)
+		{
+			throw write_error();
+		}
+		write_window();
+		flush_append();
+		index_view_.sync();
+		if (data_.size() > data_size_)
+		{
+			data_.resize(data_size_);
+		}
+	}
+
+private:
+	void close()
+	{
+		if (is_write_ && data_.is_open())
+		{
+			flush();
+		}
+	}
+
+	IndexHeader* header() const noexcept
+	{
+		return reinterpret_cast<IndexHeader*>(index_view_.data());
+	}
+
+	RecordRef* refs() const noexcept
+	{
+		return reinterpret_cast<RecordRef*>(index_view_.data() + header_size_);
+	}
+
+	void check(size_t index) const
+	{
+		if (index >= size())
+		{
+			throw goind_out_of_file();
+		}
+	}
+
+	void seek_window(size_t index)
+	{
+		if (window_first_ != no_record_ && index >= window_first_ && index - window_first_ < window_.size())
+		{
+			return;
+		}
+		write_window();
+		if (index >= count_)
+		{
+			flush_append();
+		}
+		window_first_ = index / window_records_ * window_records_;
+		window_.resize(std::min(window_records_, count_ - window_first_));
+		read_window();
+	}
+
+	//,      ,   
+	void read_window()
+	{
+		const RecordRef* ref = refs() + window_first_;
+		size_t run = 0;
+		while (run < window_.size())
+		{
+			size_t end = run + 1;
+			while (end < window_.size() && ref[end].offset == ref[end - 1].offset + ref[end - 1].capacity)
+			{
+				++end;
+			}
+			const size_t length = ref[end - 1].offset + ref[end - 1].size - ref[run].offset;
+			bytes_.resize(length);
+			data_.read_at(ref[run].offset, bytes_.data(), length);
+			for (size_t i = run; i < end; i++)
+			{
+				S::deserialization(std::span<const char>(bytes_.data() + (ref[i].offset - ref[run].offset), ref[i].size), window_[i]);
+			}
+			run = end;
+		}
+	}
+
+	//,     ,       
+	void write_window()
+	{
+		if (dirty_first_ >= dirty_last_)
+		{
+			return;
+		}
+		RecordRef* ref = refs() + window_first_;
+		bytes_.clear();
+		std::vector<char> record;
+		for (size_t i = dirty_first_; i < dirty_last_; i++)
+		{
+			const size_t size = S::get_size_element(window_[i]);
+			record.resize(size);
+			S::serialization(window_[i], std::span<char>(record));
+			if (size <= ref[i].capacity)
+			{
+				data_.write_at(ref[i].offset, record.data(), size);
+				ref[i].size = size;
+			}
+			else
+			{
+				ref[i] = { data_size_ + bytes_.size(), size, size };
+				bytes_.insert(bytes_.end(), record.begin(), record.end());
+			}
+		}
+		if (!bytes_.empty())
+		{
+			data_.write_at(data_size_, bytes_.data(), bytes_.size());
+			data_size_ += bytes_.size();
+		}
+		dirty_first_ = 0;
+		dirty_last_ = 0;
+	}
+
+	//           .
+	//        ,      .
+	void flush_append()
+	{
+		if (pending_.empty())
+		{
+			return;
+		}
+		if (!append_.empty())
+		{
+			data_.write_at(data_size_, append_.data(), append_.size());
+		}
+		const size_t need = count_ + pending_.size();
+		if (need > capacity_)
+		{
+			capacity_ = std::max(need, capacity_ * 2);
+			index_view_ = MappedView();
+			index_.resize(header_size_ + capacity_ * ref_size_);
+			index_view_ = index_.map(0, header_size_ + capacity_ * ref_size_);
+		}
+		RecordRef* ref = refs() + count_;
+		for (const RecordRef& entry : pending_)
+		{
+			*ref++ = { data_size_ + entry.offset, entry.size, entry.size };
+		}
+		data_size_ += append_.size();
+		count_ = need;
+		header()->count = count_;
+		append_.clear();
+		pending_.clear();
+	}
+};
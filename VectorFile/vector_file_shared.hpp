@@ -0,0 +1,130 @@
+#pragma once
+#include <vector>
+#include <span>
+#include <algorithm>
+#include <filesystem>
+#include "VectorFile.hpp"
+#include "file_handle.hpp"
+#include "vector_file_exception.hpp"
+
+
+// ,       .     (pread),
+//     ;              .
+//   (VectorFileHeader)  :    ,    .
+template <Acceptable T, class S = Serializer<T>>
+	requires BulkSerializer<S, T>
+class SharedVectorFile final
+{
+	static const size_t type_size_ = sizeof(T);	//  ()
+	static constexpr bool raw_ = std::is_trivially_copyable_v<T> && std::is_same_v<S, Serializer<T>>;
+	static constexpr size_t no_page_ = static_cast<size_t>(-1);
+
+	std::filesystem::path path_;	//  
+	FileHandle handle_;				// 
+	size_t file_size_;				//  ()
+	size_t data_offset_ = 0;		//    :    0 ()
+	size_t window_elems_;			//   ()
+
+public:
+	explicit SharedVectorFile(std::filesystem::path path, size_t window_size = 1024)
+		: path_(std::move(path)), handle_(path_, false), window_elems_(std::max<size_t>(1, window_size / type_size_))
+	{
+		VectorFileHeader header;
+		if (VectorFileHeader::read<T, S>(handle_, header))
+		{
+			data_offset_ = VectorFileHeader::size;
+			file_size_ = header.count * type_size_;
+		}
+		else
+		{
+			file_size_ = handle_.size() / type_size_ * type_size_;
+		}
+	}
+
+	SharedVectorFile(const SharedVectorFile&) = delete;
+	SharedVectorFile& operator=(const SharedVectorFile&) = delete;
+
+	size_t size_file() const noexcept
+	{
+		return file_size_;
+	}
+
+	const std::filesystem::path& path() const noexcept
+	{
+		return path_;
+	}
+
+	//    :    0 ()
+	size_t data_offset() const noexcept
+	{
+		return data_offset_;
+	}
+
+	//  :     .     .
+	class Cursor
+	{
+		const SharedVectorFile* file_;	// 
+		size_t page_ = no_page_;		//,   
+		std::vector<T> buffer_;			//  
+		std::vector<char> bytes_;		//   
+
+	public:
+		explicit Cursor(const SharedVectorFile& file) : file_(&file) {}
+
+		const T& operator[](size_t index)
+		{
+			if (index >= file_->file_size_ / type_size_)
+			{
+				throw goind_out_of_file();
+			}
+			const size_t page = index / file_->window_elems_;
+			if (page != page_)
+			{
+				const size_t first = page * file_->window_elems_;
+				buffer_.resize(std::min(file_->window_elems_, file_->file_size_ / type_size_ - first));
+				read(first, buffer_);
+				page_ = page;
+			}
+			return buffer_[index - page_ * file_->window_elems_];
+		}
+
+		//      ,  
+		void read_range(size_t first, std::span<T> out)
+		{
+			if ((first + out.size()) * type_size_ > file_->file_size_)
+			{
+				throw goind_out_of_file();
+			}
+			read(first, out);
+		}
+
+		size_t size_buffer() const noexcept
+		{
+			return buffer_.size();
+		}
+
+	private:
+		void read(size_t first, std::span<T> out)
+		{
+			if (out.empty())
+			{
+				return;
+			}
+			if constexpr (raw_)
+			{
+				file_->handle_.read_at(file_->data_offset_ + first * type_size_, out.data(), out.size_bytes());
+			}
+			else
+			{
+				bytes_.resize(out.size_bytes());
+				file_->handle_.read_at(file_->data_offset_ + first * type_size_, bytes_.data(), bytes_.size());
+				S::deserialization(std::span<const char>(bytes_), out);
+			}
+		}
+	};
+
+	Cursor cursor() const
+	{
+		return Cursor(*this);
+	}
+};
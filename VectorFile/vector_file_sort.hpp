@@ -0,0 +1,190 @@
+#pragma once
+#include <vector>
+#include <span>
+#include <thread>
+#include <algorithm>
+#include <functional>
+#include <filesystem>
+#include "VectorFile.hpp"
+
+
+namespace vf
+{
+	//   k- :    ,  tree_[0] - .
+	// Less(a, b)   b;    .
+	template <class Less>
+	class LoserTree final
+	{
+		std::vector<size_t> tree_;	// 
+		size_t count_;				// 
+		Less less_;
+
+	public:
+		LoserTree(size_t count, Less less) : tree_(std::max<size_t>(1, count), count), count_(count), less_(std::move(less))
+		{
+			for (size_t i = 0; i < count_; i++)
+			{
+				adjust(i);
+			}
+		}
+
+		size_t winner() const noexcept
+		{
+			return tree_[0];
+		}
+
+		//     -
+		void adjust(size_t source)
+		{
+			size_t winner = source;
+			for (size_t node = (source + count_) / 2; node > 0; node /= 2)
+			{
+				if (beats(tree_[node], winner))
+				{
+					std::swap(tree_[node], winner);
+				}
+			}
+			tree_[0] = winner;
+		}
+
+	private:
+		// count_ -   ,   ,    
+		bool beats(size_t left, size_t right)
+		{
+			if (left == count_)
+			{
+				return true;
+			}
+			if (right == count_)
+			{
+				return false;
+			}
+			return less_(left, right);
+		}
+	};
+
+
+	//  .      memory_budget ,   
+	//       ,        .
+	template <Acceptable T, class S, size_t N, class Compare = std::less<T>>
+	void sort(VectorFile<T, S, N>& vec, Compare comp = {}, size_t memory_budget = 64 << 20)
+	{
+		const size_t total = vec.size_file() / sizeof(T);
+		const size_t budget = std::max<size_t>(2, memory_budget / sizeof(T));	//  
+		if (total <= budget)
+		{
+			std::vector<T> data(total);
+			vec.read_range(0, data);
+			std::sort(data.begin(), data.end(), comp);
+			vec.write_range(0, data);
+			return;
+		}
+
+		const size_t threads = std::max<size_t>(1, std::min<size_t>(std::thread::hardware_concurrency(), budget));
+		const size_t run_size = budget / threads;	//  ()
+		std::filesystem::path runs_path = vec.path();
+		runs_path += ".runs";
+		try
+		{
+			VectorFile<T, S> runs(runs_path, static_cast<size_t>(0), sizeof(T) * 1024, { .append_buffer = 0 });
+			std::vector<size_t> bounds = { 0 };	//    
+			std::vector<std::vector<T>> chunks(threads);
+			for (size_t first = 0; first < total;)
+			{
+				size_t used = 0;
+				for (; used < threads && first < total; used++)
+				{
+					chunks[used].resize(std::min(run_size, total - first));
+					vec.read_range(first, chunks[used]);
+					first += chunks[used].size();
+				}
+				std::vector<std::thread> workers;
+				for (size_t i = 1; i < used; i++)
+				{
+					workers.emplace_back([&chunks, &comp, i] { std::sort(chunks[i].begin(), chunks[i].end(), comp); });
+				}
+				std::sort(chunks[0].begin(), chunks[0].end(), comp);
+				for (std::thread& worker : workers)
+				{
+					worker.join();
+				}
+				for (size_t i = 0; i < used; i++)
+				{
+					runs.append(std::span<const T>(chunks[i]));
+					bounds.push_back(bounds.back() + chunks[i].size());
+				}
+			}
+			chunks.clear();
+			chunks.shrink_to_fit();
+
+			struct Run
+			{
+				size_t next;			//      
+				size_t end;				// 
+				std::vector<T> buffer;	//  
+				size_t pos = 0;			//  
+			};
+			const size_t count = bounds.size() - 1;
+			const size_t buffer_size = std::max<size_t>(1, budget / (count + 1));
+			std::vector<Run> sources;
+			sources.reserve(count);
+			for (size_t i = 0; i < count; i++)
+			{
+				sources.push_back({ bounds[i], bounds[i + 1], {} });
+			}
+			auto refill = [&runs, buffer_size](Run& run)
+			{
+				run.buffer.resize(std::min(buffer_size, run.end - run.next));
+				runs.read_range(run.next, run.buffer);
+				run.next += run.buffer.size();
+				run.pos = 0;
+			};
+			for (Run& run : sources)
+			{
+				refill(run);
+			}
+
+			auto less = [&sources, &comp](size_t left, size_t right)
+			{
+				const Run& a = sources[left];
+				const Run& b = sources[right];
+				if (a.pos == a.buffer.size())
+				{
+					return false;
+				}
+				if (b.pos == b.buffer.size())
+				{
+					return true;
+				}
+				return comp(a.buffer[a.pos], b.buffer[b.pos]);
+			};
+			LoserTree<decltype(less)> tree(count, less);
+			std::vector<T> out;
+			out.reserve(buffer_size);
+			size_t written = 0;
+			for (size_t i = 0; i < total; i++)
+			{
+				Run& run = sources[tree.winner()];
+				out.push_back(std::move(run.buffer[run.pos++]));
+				if (run.pos == run.buffer.size() && run.next < run.end)
+				{
+					refill(run);
+				}
+				tree.adjust(tree.winner());
+				if (out.size() == buffer_size)
+				{
+					vec.write_range(written, out);
+					written += out.size();
+					out.clear();
+				}
+			}
+			vec.write_range(written, out);
+		}
+		catch (...)
+		{
+			std::filesystem::remove(runs_path);
+			throw;
+		}
+		std::filesystem::remove(runs_path);
+	}
+}
@@ -0,0 +1,157 @@
+#pragma once
+#include <vector>
+#include <span>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <filesystem>
+#include <memory>
+#include <algorithm>
+#include "file_handle.hpp"
+#include "io_engine.hpp"
+
+
+//      .
+//      -   :      chunk_ ,
+//  .         .
+//Raw -      T,       S.
+template <class T, class S, bool Raw>
+class WindowPrefetcher final
+{
+	static constexpr size_t chunk_ = 1 << 20;	//     ()
+
+	std::unique_ptr<IoEngine> engine_;	//  
+	std::mutex mutex_;
+	std::condition_variable cv_;
+	bool stop_ = false;				//  
+	bool pending_ = false;			//  
+	bool loading_ = false;			//  
+	bool ready_ = false;			// 
+	size_t request_id_ = 0;			//  
+	size_t page_ = 0;				// 
+	size_t offset_ = 0;				//  ()
+	size_t count_ = 0;				//  
+	WindowBuffer<T> buffer_;		//  
+	std::vector<char> bytes_;		//   
+	std::vector<IoRequest> requests_;	//  
+	std::thread worker_;
+
+public:
+	explicit WindowPrefetcher(const std::filesystem::path& path, IoEngineKind engine = IoEngineKind::positional)
+		: engine_(make_io_engine(engine, path, false)), worker_([this] { run(); })
+	{
+	}
+
+	~WindowPrefetcher()
+	{
+		{
+			std::lock_guard lock(mutex_);
+			stop_ = true;
+		}
+		cv_.notify_all();
+		worker_.join();
+	}
+
+	WindowPrefetcher(const WindowPrefetcher&) = delete;
+	WindowPrefetcher& operator=(const WindowPrefetcher&) = delete;
+
+	void request(size_t page, size_t offset, size_t count)
+	{
+		{
+			std::lock_guard lock(mutex_);
+			if ((pending_ || loading_ || ready_) && page_ == page && count_ == count)
+			{
+				return;
+			}
+			++request_id_;
+			page_ = page;
+			offset_ = offset;
+			count_ = count;
+			pending_ = true;
+			ready_ = false;
+		}
+		cv_.notify_all();
+	}
+
+	// ,        .   .
+	bool take(size_t page, size_t count, WindowBuffer<T>& buffer)
+	{
+		std::unique_lock lock(mutex_);
+		if (!(pending_ || loading_ || ready_) || page_ != page || count_ != count)
+		{
+			return false;
+		}
+		cv_.wait(lock, [this] { return !pending_ && !loading_; });
+		if (!ready_)
+		{
+			return false;
+		}
+		ready_ = false;
+		buffer.swap(buffer_);
+		return true;
+	}
+
+	// :      
+	void cancel()
+	{
+		std::lock_guard lock(mutex_);
+		++request_id_;
+		pending_ = false;
+		ready_ = false;
+	}
+
+private:
+	void run()
+	{
+		std::unique_lock lock(mutex_);
+		while (true)
+		{
+			cv_.wait(lock, [this] { return stop_ || pending_; });
+			if (stop_)
+			{
+				return;
+			}
+			pending_ = false;
+			loading_ = true;
+			const size_t id = request_id_;
+			const size_t offset = offset_;
+			const size_t count = count_;
+			lock.unlock();
+
+			bool done = true;
+			try
+			{
+				buffer_.resize(count);
+				if constexpr (Raw)
+				{
+					load(offset, reinterpret_cast<char*>(buffer_.data()), count * sizeof(T));
+				}
+				else
+				{
+					bytes_.resize(count * sizeof(T));
+					load(offset, bytes_.data(), bytes_.size());
+					S::deserialization(std::span<const char>(bytes_), std::span<T>(buffer_));
+				}
+			}
+			catch (...)
+			{
+				done = false;
+			}
+
+			lock.lock();
+			loading_ = false;
+			ready_ = done && id == request_id_;
+			cv_.notify_all();
+		}
+	}
+
+	void load(size_t offset, char* data, size_t length)
+	{
+		requests_.clear();
+		for (size_t done = 0; done < length; done += chunk_)
+		{
+			requests_.push_back({ false, offset + done, data + done, std::min(chunk_, length - done) });
+		}
+		engine_->submit(requests_);
+	}
+};
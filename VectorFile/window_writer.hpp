@@ -0,0 +1,200 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <span>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <utility>
+#include <filesystem>
+#include <memory>
+#include "file_handle.hpp"
+#include "io_engine.hpp"
+
+
+//   .       ,
+//       ,        
+// -      .
+//Raw -      T,       S.
+template <class T, class S, bool Raw>
+class WindowWriter final
+{
+	struct Item
+	{
+		size_t offset;				//     ()
+		WindowBuffer<T> buffer;		// 
+		size_t first;				//   ()
+		size_t last;				//   (,  )
+	};
+
+	std::unique_ptr<IoEngine> engine_;	//  
+	size_t capacity_;					//   ()
+	std::mutex mutex_;
+	std::condition_variable cv_;
+	std::deque<Item> queue_;			//,  
+	std::vector<Item> batch_;			//,  
+	bool stop_ = false;					//  
+	std::exception_ptr error_;			// ,  
+	std::vector<WindowBuffer<T>> free_;	//    
+	std::vector<std::vector<char>> staging_;	//   ( )
+	std::vector<IoRequest> requests_;	// 
+	std::thread worker_;
+
+public:
+	WindowWriter(const std::filesystem::path& path, size_t capacity, IoEngineKind engine = IoEngineKind::positional)
+		: engine_(make_io_engine(engine, path, true)), capacity_(capacity), worker_([this] { run(); })
+	{
+	}
+
+	~WindowWriter()
+	{
+		{
+			std::unique_lock lock(mutex_);
+			cv_.wait(lock, [this] { return queue_.empty() && batch_.empty(); });
+			stop_ = true;
+		}
+		cv_.notify_all();
+		worker_.join();
+	}
+
+	WindowWriter(const WindowWriter&) = delete;
+	WindowWriter& operator=(const WindowWriter&) = delete;
+
+	//   ;     
+	void push(size_t offset, WindowBuffer<T>&& buffer, size_t first, size_t last)
+	{
+		{
+			std::unique_lock lock(mutex_);
+			cv_.wait(lock, [this] { return queue_.size() < capacity_ || error_; });
+			rethrow();
+			queue_.push_back({ offset, std::move(buffer), first, last });
+		}
+		cv_.notify_all();
+	}
+
+	WindowBuffer<T> recycle()
+	{
+		std::lock_guard lock(mutex_);
+		if (free_.empty())
+		{
+			return {};
+		}
+		WindowBuffer<T> buffer = std::move(free_.back());
+		free_.pop_back();
+		return buffer;
+	}
+
+	bool pending(size_t offset, size_t length)
+	{
+		std::lock_guard lock(mutex_);
+		return overlaps(offset, offset + length);
+	}
+
+	//   ,   [offset, offset + length)
+	void wait_for(size_t offset, size_t length)
+	{
+		std::unique_lock lock(mutex_);
+		cv_.wait(lock, [&] { return !overlaps(offset, offset + length) || error_; });
+		rethrow();
+	}
+
+	void drain()
+	{
+		std::unique_lock lock(mutex_);
+		cv_.wait(lock, [this] { return (queue_.empty() && batch_.empty()) || error_; });
+		rethrow();
+	}
+
+private:
+	bool overlaps(size_t first, size_t last) const
+	{
+		return overlaps(batch_, first, last) || overlaps(queue_, first, last);
+	}
+
+	template <class Items>
+	static bool overlaps(const Items& items, size_t first, size_t last)
+	{
+		for (const Item& item : items)
+		{
+			if (item.offset + item.first * sizeof(T) < last && first < item.offset + item.last * sizeof(T))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void rethrow()
+	{
+		if (error_)
+		{
+			std::exception_ptr error = std::exchange(error_, nullptr);
+			std::rethrow_exception(error);
+		}
+	}
+
+	void run()
+	{
+		std::unique_lock lock(mutex_);
+		while (true)
+		{
+			cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+			if (queue_.empty())
+			{
+				return;
+			}
+			//    : ,   ,   
+			while (!queue_.empty() && !overlaps(batch_, queue_.front().offset + queue_.front().first * sizeof(T), queue_.front().offset + queue_.front().last * sizeof(T)))
+			{
+				batch_.push_back(std::move(queue_.front()));
+				queue_.pop_front();
+			}
+			lock.unlock();
+			cv_.notify_all();
+
+			std::exception_ptr error;
+			try
+			{
+				submit_batch();
+			}
+			catch (...)
+			{
+				error = std::current_exception();
+			}
+
+			lock.lock();
+			if (error)
+			{
+				error_ = error;
+			}
+			for (Item& item : batch_)
+			{
+				item.buffer.clear();
+				free_.push_back(std::move(item.buffer));
+			}
+			batch_.clear();
+			cv_.notify_all();
+		}
+	}
+
+	void submit_batch()
+	{
+		requests_.clear();
+		staging_.resize(batch_.size());
+		for (size_t i = 0; i < batch_.size(); i++)
+		{
+			Item& item = batch_[i];
+			const size_t count = item.last - item.first;
+			void* data = item.buffer.data() + item.first;
+			if constexpr (!Raw)
+			{
+				staging_[i].resize(count * sizeof(T));
+				S::serialization(std::span<const T>(item.buffer.data() + item.first, count), std::span<char>(staging_[i]));
+				data = staging_[i].data();
+			}
+			requests_.push_back({ true, item.offset + item.first * sizeof(T), data, count * sizeof(T) });
+		}
+		engine_->submit(requests_);
+	}
+};